@@ -0,0 +1,124 @@
+#ifndef CHAR_SCAN_H
+#define CHAR_SCAN_H
+
+#include <cstddef>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CHAR_SCAN_X86 1
+#endif
+
+// Finds the end of whitespace, word ([A-Za-z0-9_.]) and digit runs. On x86
+// 16 (SSE2) or 32 (AVX2) bytes are classified per step; the scalar loop
+// handles the tail and other targets. Every path uses the C-locale classes,
+// so bytes >= 0x80 never belong to a run, matching isspace/isalnum on char.
+
+enum ScanMode { SCAN_SCALAR, SCAN_SSE2, SCAN_AVX2 };
+enum RunKind { RUN_SPACE, RUN_WORD, RUN_DIGIT };
+
+namespace char_scan {
+
+template <RunKind R>
+inline bool inRun(unsigned char c) {
+    if (R == RUN_SPACE) return c == ' ' || (c >= '\t' && c <= '\r');
+    if (R == RUN_DIGIT) return c >= '0' && c <= '9';
+    return ((c | 0x20) >= 'a' && (c | 0x20) <= 'z') || (c >= '0' && c <= '9') || c == '_' || c == '.';
+}
+
+template <RunKind R>
+inline size_t scalarRun(const char* p, size_t i, size_t n) {
+    while (i < n && inRun<R>(p[i])) ++i;
+    return i;
+}
+
+#ifdef CHAR_SCAN_X86
+
+// Lanes with lo <= byte <= hi, using one signed compare after re-biasing.
+inline __m128i inRange16(__m128i v, char lo, char hi) {
+    __m128i shifted = _mm_add_epi8(v, _mm_set1_epi8((char)(0x80 - lo)));
+    return _mm_cmplt_epi8(shifted, _mm_set1_epi8((char)(-128 + (hi - lo) + 1)));
+}
+
+template <RunKind R>
+inline __m128i classify16(__m128i v) {
+    if (R == RUN_SPACE)
+        return _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), inRange16(v, '\t', '\r'));
+    if (R == RUN_DIGIT) return inRange16(v, '0', '9');
+    __m128i letter = inRange16(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 'z');
+    __m128i extra = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('_')), _mm_cmpeq_epi8(v, _mm_set1_epi8('.')));
+    return _mm_or_si128(_mm_or_si128(letter, inRange16(v, '0', '9')), extra);
+}
+
+template <RunKind R>
+inline size_t sse2Run(const char* p, size_t i, size_t n) {
+    while (i + 16 <= n) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        unsigned outside = ~_mm_movemask_epi8(classify16<R>(v)) & 0xFFFF;
+        if (outside) return i + __builtin_ctz(outside);
+        i += 16;
+    }
+    return scalarRun<R>(p, i, n);
+}
+
+__attribute__((target("avx2"))) inline __m256i inRange32(__m256i v, char lo, char hi) {
+    __m256i shifted = _mm256_add_epi8(v, _mm256_set1_epi8((char)(0x80 - lo)));
+    return _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(-128 + (hi - lo) + 1)), shifted);
+}
+
+template <RunKind R>
+__attribute__((target("avx2"))) inline __m256i classify32(__m256i v) {
+    if (R == RUN_SPACE)
+        return _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')), inRange32(v, '\t', '\r'));
+    if (R == RUN_DIGIT) return inRange32(v, '0', '9');
+    __m256i letter = inRange32(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), 'a', 'z');
+    __m256i extra = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('_')),
+                                    _mm256_cmpeq_epi8(v, _mm256_set1_epi8('.')));
+    return _mm256_or_si256(_mm256_or_si256(letter, inRange32(v, '0', '9')), extra);
+}
+
+template <RunKind R>
+__attribute__((target("avx2"))) inline size_t avx2Run(const char* p, size_t i, size_t n) {
+    while (i + 32 <= n) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        unsigned outside = ~(unsigned)_mm256_movemask_epi8(classify32<R>(v));
+        if (outside) return i + __builtin_ctz(outside);
+        i += 32;
+    }
+    return sse2Run<R>(p, i, n);
+}
+
+#endif
+
+inline ScanMode bestMode() {
+#ifdef CHAR_SCAN_X86
+    return __builtin_cpu_supports("avx2") ? SCAN_AVX2 : SCAN_SSE2;
+#else
+    return SCAN_SCALAR;
+#endif
+}
+
+template <RunKind R>
+inline size_t run(std::string_view s, size_t i, ScanMode mode) {
+#ifdef CHAR_SCAN_X86
+    if (mode == SCAN_AVX2) return avx2Run<R>(s.data(), i, s.size());
+    if (mode == SCAN_SSE2) return sse2Run<R>(s.data(), i, s.size());
+#endif
+    return scalarRun<R>(s.data(), i, s.size());
+}
+
+} // namespace char_scan
+
+// Selected once at startup; set to SCAN_SCALAR to force the fallback.
+inline ScanMode scanMode = char_scan::bestMode();
+
+inline const char* scanModeName(ScanMode mode) {
+    return mode == SCAN_AVX2 ? "AVX2" : mode == SCAN_SSE2 ? "SSE2" : "scalar";
+}
+
+// Index of the first byte at or after i that is not part of the run.
+inline size_t skipSpace(std::string_view s, size_t i) { return char_scan::run<RUN_SPACE>(s, i, scanMode); }
+inline size_t skipWord(std::string_view s, size_t i) { return char_scan::run<RUN_WORD>(s, i, scanMode); }
+inline size_t skipDigits(std::string_view s, size_t i) { return char_scan::run<RUN_DIGIT>(s, i, scanMode); }
+
+#endif
@@ -0,0 +1,226 @@
+#ifndef COMMENT_SCAN_H
+#define COMMENT_SCAN_H
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include "char_scan.h"
+
+// Separates code from comments without looking at every byte: code is
+// searched 16 or 32 bytes per step for the only bytes that matter there
+// ('/', '"', '\''), a comment body for the "*/" pair, and a literal with
+// memchr for its closing quote. Literals are kept whole, so "//" or "/*"
+// inside one is not a comment, and must close on their line; a quote with
+// no partner on its line is an ordinary character.
+
+namespace comment_scan {
+
+constexpr size_t npos = std::string_view::npos;
+
+inline bool interesting(unsigned char c) { return c == '/' || c == '"' || c == '\''; }
+
+inline size_t scalarFindInteresting(const char* p, size_t i, size_t n) {
+    while (i < n && !interesting(p[i])) ++i;
+    return i;
+}
+
+inline size_t scalarFindCommentEnd(const char* p, size_t i, size_t n) {
+    while (i + 1 < n) {
+        const void* star = std::memchr(p + i, '*', n - 1 - i);
+        if (!star) return npos;
+        i = static_cast<const char*>(star) - p;
+        if (p[i + 1] == '/') return i;
+        ++i;
+    }
+    return npos;
+}
+
+inline size_t scalarCountNewlines(const char* p, size_t i, size_t n) {
+    return std::count(p + i, p + n, '\n');
+}
+
+#ifdef CHAR_SCAN_X86
+
+inline size_t sse2FindInteresting(const char* p, size_t i, size_t n) {
+    const __m128i slash = _mm_set1_epi8('/'), dquote = _mm_set1_epi8('"'), squote = _mm_set1_epi8('\'');
+    while (i + 16 <= n) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        __m128i hit = _mm_or_si128(_mm_cmpeq_epi8(v, slash),
+                                   _mm_or_si128(_mm_cmpeq_epi8(v, dquote), _mm_cmpeq_epi8(v, squote)));
+        unsigned mask = _mm_movemask_epi8(hit);
+        if (mask) return i + __builtin_ctz(mask);
+        i += 16;
+    }
+    return scalarFindInteresting(p, i, n);
+}
+
+// A '*' lane whose next byte is '/': the second load is offset by one.
+inline size_t sse2FindCommentEnd(const char* p, size_t i, size_t n) {
+    const __m128i star = _mm_set1_epi8('*'), slash = _mm_set1_epi8('/');
+    while (i + 17 <= n) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 1));
+        unsigned mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, star), _mm_cmpeq_epi8(b, slash)));
+        if (mask) return i + __builtin_ctz(mask);
+        i += 16;
+    }
+    return scalarFindCommentEnd(p, i, n);
+}
+
+inline size_t sse2CountNewlines(const char* p, size_t i, size_t n) {
+    const __m128i newline = _mm_set1_epi8('\n');
+    size_t count = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        count += __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(v, newline)));
+    }
+    return count + scalarCountNewlines(p, i, n);
+}
+
+__attribute__((target("avx2"))) inline size_t avx2FindInteresting(const char* p, size_t i, size_t n) {
+    const __m256i slash = _mm256_set1_epi8('/'), dquote = _mm256_set1_epi8('"'), squote = _mm256_set1_epi8('\'');
+    while (i + 32 <= n) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        __m256i hit = _mm256_or_si256(_mm256_cmpeq_epi8(v, slash),
+                                      _mm256_or_si256(_mm256_cmpeq_epi8(v, dquote), _mm256_cmpeq_epi8(v, squote)));
+        unsigned mask = _mm256_movemask_epi8(hit);
+        if (mask) return i + __builtin_ctz(mask);
+        i += 32;
+    }
+    return sse2FindInteresting(p, i, n);
+}
+
+__attribute__((target("avx2"))) inline size_t avx2FindCommentEnd(const char* p, size_t i, size_t n) {
+    const __m256i star = _mm256_set1_epi8('*'), slash = _mm256_set1_epi8('/');
+    while (i + 33 <= n) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 1));
+        unsigned mask = _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, star), _mm256_cmpeq_epi8(b, slash)));
+        if (mask) return i + __builtin_ctz(mask);
+        i += 32;
+    }
+    return sse2FindCommentEnd(p, i, n);
+}
+
+__attribute__((target("avx2"))) inline size_t avx2CountNewlines(const char* p, size_t i, size_t n) {
+    const __m256i newline = _mm256_set1_epi8('\n');
+    size_t count = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        count += __builtin_popcount(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, newline)));
+    }
+    return count + sse2CountNewlines(p, i, n);
+}
+
+#endif
+
+// Index of the first '/', '"' or '\'' at or after i, or s.size().
+inline size_t findInteresting(std::string_view s, size_t i) {
+#ifdef CHAR_SCAN_X86
+    if (scanMode == SCAN_AVX2) return avx2FindInteresting(s.data(), i, s.size());
+    if (scanMode == SCAN_SSE2) return sse2FindInteresting(s.data(), i, s.size());
+#endif
+    return scalarFindInteresting(s.data(), i, s.size());
+}
+
+inline size_t countNewlines(std::string_view s) {
+#ifdef CHAR_SCAN_X86
+    if (scanMode == SCAN_AVX2) return avx2CountNewlines(s.data(), 0, s.size());
+    if (scanMode == SCAN_SSE2) return sse2CountNewlines(s.data(), 0, s.size());
+#endif
+    return scalarCountNewlines(s.data(), 0, s.size());
+}
+
+} // namespace comment_scan
+
+// Index just past the "*/" at or after i, or npos if the comment does not
+// end in s.
+inline size_t findCommentEnd(std::string_view s, size_t i) {
+    using namespace comment_scan;
+    size_t star;
+#ifdef CHAR_SCAN_X86
+    if (scanMode == SCAN_AVX2) star = avx2FindCommentEnd(s.data(), i, s.size());
+    else if (scanMode == SCAN_SSE2) star = sse2FindCommentEnd(s.data(), i, s.size());
+    else
+#endif
+    star = scalarFindCommentEnd(s.data(), i, s.size());
+    return star == npos ? npos : star + 2;
+}
+
+// Index just past the quote closing the literal that opens at s[i], or npos
+// if it does not close. A quote preceded by an odd number of backslashes is
+// escaped.
+inline size_t skipQuoted(std::string_view s, size_t i) {
+    const char quote = s[i];
+    for (size_t j = i + 1; j < s.size();) {
+        const void* hit = std::memchr(s.data() + j, quote, s.size() - j);
+        if (!hit) return std::string_view::npos;
+        size_t k = static_cast<const char*>(hit) - s.data();
+        size_t slashes = 0;
+        while (k - slashes > i + 1 && s[k - slashes - 1] == '\\') ++slashes;
+        if (slashes % 2 == 0) return k + 1;
+        j = k + 1;
+    }
+    return std::string_view::npos;
+}
+
+// Calls code(segment) for every part of line outside comments, in order,
+// and returns whether the line ends inside a /* */ comment. A comment
+// between two segments separates them like whitespace.
+template <typename F>
+bool forEachCodeSegment(std::string_view line, bool inComment, F&& code) {
+    const size_t n = line.size();
+    size_t start = 0;
+    if (inComment) {
+        size_t end = findCommentEnd(line, 0);
+        if (end == std::string_view::npos) return true;
+        start = end;
+    }
+    for (size_t i = start; (i = comment_scan::findInteresting(line, i)) < n;) {
+        if (line[i] != '/') {
+            size_t close = skipQuoted(line, i);
+            i = close == std::string_view::npos ? i + 1 : close;
+        } else if (i + 1 < n && line[i + 1] == '/') {
+            if (i > start) code(line.substr(start, i - start));
+            return false;
+        } else if (i + 1 < n && line[i + 1] == '*') {
+            if (i > start) code(line.substr(start, i - start));
+            size_t end = findCommentEnd(line, i + 2);
+            if (end == std::string_view::npos) return true;
+            i = start = end;
+        } else {
+            ++i;
+        }
+    }
+    if (start < n) code(line.substr(start));
+    return false;
+}
+
+// Calls f(lineNo, segment) for every code segment of text, numbering lines
+// from firstLine, and returns whether text ends inside a comment. A comment
+// spanning lines is crossed in one search for its "*/".
+template <typename F>
+bool forEachCodeSpan(std::string_view text, F&& f, int firstLine = 1, bool inComment = false) {
+    const size_t n = text.size();
+    int lineNo = firstLine;
+    size_t i = 0;
+    while (i < n) {
+        if (inComment) {
+            size_t end = findCommentEnd(text, i);
+            size_t stop = end == std::string_view::npos ? n : end;
+            lineNo += comment_scan::countNewlines(text.substr(i, stop - i));
+            if (end == std::string_view::npos) return true;
+            i = end;
+            inComment = false;
+        }
+        size_t lineEnd = text.find('\n', i);
+        if (lineEnd == std::string_view::npos) lineEnd = n;
+        inComment = forEachCodeSegment(text.substr(i, lineEnd - i), false,
+                                       [&](std::string_view segment) { f(lineNo, segment); });
+        i = lineEnd + 1;
+        ++lineNo;
+    }
+    return inComment;
+}
+
+#endif
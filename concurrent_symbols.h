@@ -0,0 +1,148 @@
+#ifndef CONCURRENT_SYMBOLS_H
+#define CONCURRENT_SYMBOLS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string_view>
+#include "string_interner.h"
+
+// Insert-only hash table of lexemes shared by lexing threads. Buckets are
+// atomic chain heads: lookups never lock, and an insert publishes a new
+// entry with one compare-and-swap on its bucket, retrying only if another
+// thread pushed onto the same bucket meanwhile. Each entry keeps the lowest
+// position it was inserted with, lowered by CAS, so the first declaration
+// does not depend on thread timing.
+class ConcurrentSymbolTable {
+public:
+    struct Entry {
+        std::string_view lexeme;         // bytes owned by the table
+        uint32_t hash;
+        unsigned char kind;
+        std::atomic<uint64_t> firstSeen; // lowest position inserted
+        Entry* next;                     // bucket chain, fixed once published
+        uint32_t id;                     // free for the owner once inserts are done
+    };
+
+    // expectedSymbols only sizes the bucket array; chains absorb any excess.
+    explicit ConcurrentSymbolTable(size_t expectedSymbols) {
+        size_t n = 1024;
+        while (n < expectedSymbols) n *= 2;
+        buckets.reset(new std::atomic<Entry*>[n]);
+        for (size_t b = 0; b < n; ++b) buckets[b].store(nullptr, std::memory_order_relaxed);
+        mask = n - 1;
+        blocks.store(nullptr, std::memory_order_relaxed);
+    }
+
+    ~ConcurrentSymbolTable() {
+        for (Block* b = blocks.load(); b;) {
+            Block* prev = b->prev;
+            ::operator delete(b);
+            b = prev;
+        }
+    }
+
+    ConcurrentSymbolTable(const ConcurrentSymbolTable&) = delete;
+    ConcurrentSymbolTable& operator=(const ConcurrentSymbolTable&) = delete;
+
+    // Adds lexeme if it is new, and lowers its first position to position.
+    // Safe to call from any number of threads at once.
+    Entry* insert(std::string_view lexeme, unsigned char kind, uint64_t position) {
+        uint32_t h = StringInterner::hashOf(lexeme);
+        std::atomic<Entry*>& bucket = buckets[h & mask];
+        Entry* head = bucket.load(std::memory_order_acquire);
+        Entry* e = findIn(head, nullptr, lexeme, h);
+        Entry* fresh = nullptr;
+
+        while (!e) {
+            if (!fresh) fresh = newEntry(lexeme, h, kind, position);
+            fresh->next = head;
+            Entry* seen = head;
+            if (bucket.compare_exchange_weak(head, fresh, std::memory_order_release, std::memory_order_acquire)) {
+                count.fetch_add(1, std::memory_order_relaxed);
+                return fresh;
+            }
+            // Someone else pushed first; only the entries they added are new
+            e = findIn(head, seen, lexeme, h);
+        }
+        // A lost race leaves fresh unused in the arena; it is never linked.
+
+        uint64_t current = e->firstSeen.load(std::memory_order_relaxed);
+        while (position < current &&
+               !e->firstSeen.compare_exchange_weak(current, position, std::memory_order_relaxed)) {}
+        return e;
+    }
+
+    Entry* find(std::string_view lexeme) const {
+        uint32_t h = StringInterner::hashOf(lexeme);
+        return findIn(buckets[h & mask].load(std::memory_order_acquire), nullptr, lexeme, h);
+    }
+
+    size_t size() const { return count.load(std::memory_order_relaxed); }
+
+    // Calls f(Entry&) for every entry. Not safe while inserts are running.
+    template <typename F>
+    void forEach(F&& f) {
+        for (size_t b = 0; b <= mask; ++b)
+            for (Entry* e = buckets[b].load(std::memory_order_acquire); e; e = e->next) f(*e);
+    }
+
+private:
+    struct Block {
+        Block* prev;
+        size_t capacity;
+        std::atomic<size_t> used;
+        alignas(alignof(Entry)) char data[1];
+    };
+    static constexpr size_t BLOCK_SIZE = 1 << 20;
+
+    std::unique_ptr<std::atomic<Entry*>[]> buckets;
+    size_t mask;
+    std::atomic<size_t> count{0};
+    std::atomic<Block*> blocks;
+
+    // Scans a chain from head up to (not including) stop.
+    static Entry* findIn(Entry* head, Entry* stop, std::string_view lexeme, uint32_t h) {
+        for (Entry* e = head; e != stop; e = e->next)
+            if (e->hash == h && e->lexeme == lexeme) return e;
+        return nullptr;
+    }
+
+    Entry* newEntry(std::string_view lexeme, uint32_t h, unsigned char kind, uint64_t position) {
+        char* p = static_cast<char*>(allocate(sizeof(Entry) + lexeme.size()));
+        char* bytes = p + sizeof(Entry);
+        std::memcpy(bytes, lexeme.data(), lexeme.size());
+        Entry* e = new (p) Entry;
+        e->lexeme = std::string_view(bytes, lexeme.size());
+        e->hash = h;
+        e->kind = kind;
+        e->firstSeen.store(position, std::memory_order_relaxed);
+        e->next = nullptr;
+        e->id = 0;
+        return e;
+    }
+
+    // Lock-free bump allocation from a list of blocks.
+    void* allocate(size_t bytes) {
+        bytes = (bytes + alignof(Entry) - 1) & ~(alignof(Entry) - 1);
+        for (;;) {
+            Block* b = blocks.load(std::memory_order_acquire);
+            if (b) {
+                size_t offset = b->used.fetch_add(bytes, std::memory_order_relaxed);
+                if (offset + bytes <= b->capacity) return b->data + offset;
+            }
+            size_t capacity = std::max(bytes, BLOCK_SIZE);
+            Block* fresh = new (::operator new(sizeof(Block) + capacity)) Block;
+            fresh->prev = b;
+            fresh->capacity = capacity;
+            fresh->used.store(bytes, std::memory_order_relaxed);
+            if (blocks.compare_exchange_strong(b, fresh, std::memory_order_acq_rel)) return fresh->data;
+            ::operator delete(fresh);
+        }
+    }
+};
+
+#endif
@@ -5,8 +5,21 @@
 #include <set>
 #include <stack>
 #include <algorithm>
+#include <numeric>
 #include <sstream>
 #include <iomanip>  // For table formatting
+#include <array>
+#include <bitset>
+#include <chrono>
+#include <random>
+#include <string_view>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+#include <regex>
+#include <fstream>
 
 using namespace std;
 
@@ -14,48 +27,249 @@ using namespace std;
 #define UNION '|'
 #define STAR '*'
 #define CONCAT '.'
+#define PLUS '+'
+#define OPTIONAL '?'
+
+using ByteSet = bitset<256>;
 
 int positionCounter = 1;
 
-// Syntax Tree Node
+// Set of positions stored as a bitset over just the 64-bit words it spans.
+// Positions under one subtree are numbered consecutively, so firstpos and
+// lastpos stay a few words long, and unions and intersections are
+// word-parallel loops. Leading and trailing zero words are trimmed, so equal
+// sets have equal representations and can be hashed as DFA states.
+class PositionSet {
+public:
+    void insert(int p) {
+        PositionSet one;
+        one.base = p / 64;
+        one.words.push_back(1ull << (p % 64));
+        *this |= one;
+    }
+
+    bool contains(int p) const {
+        size_t w = p / 64;
+        return w >= base && w < base + words.size() && (words[w - base] >> (p % 64) & 1);
+    }
+
+    bool empty() const { return words.empty(); }
+
+    PositionSet& operator|=(const PositionSet& o) {
+        if (o.empty()) return *this;
+        if (empty()) return *this = o;
+        size_t lo = min(base, o.base), hi = max(base + words.size(), o.base + o.words.size());
+        if (lo != base || hi != base + words.size()) {
+            vector<uint64_t> wider(hi - lo, 0);
+            copy(words.begin(), words.end(), wider.begin() + (base - lo));
+            words.swap(wider);
+            base = lo;
+        }
+        uint64_t* dst = words.data() + (o.base - base);
+        const uint64_t* src = o.words.data();
+        for (size_t i = 0, n = o.words.size(); i < n; ++i) dst[i] |= src[i];
+        return *this;
+    }
+
+    PositionSet operator&(const PositionSet& o) const {
+        PositionSet r;
+        size_t lo = max(base, o.base), hi = min(base + words.size(), o.base + o.words.size());
+        if (lo >= hi) return r;
+        r.base = lo;
+        r.words.resize(hi - lo);
+        const uint64_t* a = words.data() + (lo - base);
+        const uint64_t* b = o.words.data() + (lo - o.base);
+        for (size_t i = 0; i < hi - lo; ++i) r.words[i] = a[i] & b[i];
+        r.trim();
+        return r;
+    }
+
+    // Calls f(p) for every position, in increasing order.
+    template <typename F>
+    void forEach(F&& f) const {
+        for (size_t i = 0; i < words.size(); ++i)
+            for (uint64_t w = words[i]; w; w &= w - 1) f(int((base + i) * 64 + __builtin_ctzll(w)));
+    }
+
+    bool operator==(const PositionSet& o) const { return base == o.base && words == o.words; }
+
+    size_t hash() const {
+        uint64_t h = base * 0x9E3779B97F4A7C15ull;
+        for (uint64_t w : words) h = (h ^ w) * 0x100000001B3ull, h ^= h >> 29;
+        return h;
+    }
+
+    // Heap bytes held by the set.
+    size_t memoryUsage() const { return words.capacity() * sizeof(uint64_t); }
+
+private:
+    size_t base = 0;          // word index of words[0]
+    vector<uint64_t> words;
+
+    void trim() {
+        size_t first = 0, last = words.size();
+        while (first < last && words[first] == 0) ++first;
+        while (last > first && words[last - 1] == 0) --last;
+        words.erase(words.begin() + last, words.end());
+        words.erase(words.begin(), words.begin() + first);
+        base = words.empty() ? 0 : base + first;
+    }
+};
+
+struct PositionSetHash {
+    size_t operator()(const PositionSet& s) const { return s.hash(); }
+};
+
+// Syntax Tree Node. Nodes live in one arena, syntaxTree, and refer to
+// their children by index, so a whole tree is freed in one step.
 struct Node {
     char symbol;
-    Node *left, *right;
+    int left, right; // arena indices, -1 for none
 
     bool nullable;
-    set<int> firstpos, lastpos;
+    PositionSet firstpos, lastpos;
     int pos; // valid only for leaf nodes
-    Node(char sym) : symbol(sym), left(nullptr), right(nullptr), nullable(false), pos(0) {}
+    ByteSet bytes;   // leaf: the input bytes it matches
+    int token;       // leaf: the token an end marker accepts, else -1
+    string label;    // leaf: its spelling in the regex
+    Node(char sym, int l = -1, int r = -1) : symbol(sym), left(l), right(r), nullable(false), pos(0), token(-1) {}
 };
 
 // Globals
-map<int, set<int>> followposMap;
-map<char, set<int>> positionsOfSymbol;
-vector<Node*> positionNodes;
+vector<PositionSet> followposMap;   // indexed by position
+vector<PositionSet> positionsOfSymbol; // indexed by input symbol (byte class)
+array<int, 256> symbolOf;           // byte -> input symbol, or -1 if no leaf matches it
+vector<string> symbolLabels;
+vector<Node> syntaxTree;            // node arena of the current regex
+vector<int> positionNodes;          // arena index of each position's leaf
+
+// End markers of the compiled regex and the tokens they accept.
+struct EndMarkers {
+    PositionSet positions;
+    vector<int> tokenAt;  // indexed by position
+    vector<int> priority; // per token; higher wins, then the lower token id
+
+    void add(int pos, int token) {
+        positions.insert(pos);
+        if (tokenAt.size() <= (size_t)pos) tokenAt.resize(pos + 1, -1);
+        tokenAt[pos] = token;
+    }
+
+    // Best token among the end markers in S, or -1 if there are none.
+    int acceptedToken(const PositionSet& S) const {
+        int best = -1;
+        (S & positions).forEach([&](int p) {
+            int t = tokenAt[p];
+            if (best < 0 || priority[t] > priority[best] || (priority[t] == priority[best] && t < best)) best = t;
+        });
+        return best;
+    }
+};
+EndMarkers endMarkers;
+
+// One unit of a tokenized regex: an operator or parenthesis, or (op == 0)
+// a leaf matching a set of bytes or an end marker accepting token.
+struct RegexToken {
+    char op;
+    ByteSet bytes;
+    int token;
+    string text;
+};
 
 // Helpers
 bool isOperator(char c) {
-    return c == UNION || c == STAR || c == CONCAT;
+    return c == UNION || c == STAR || c == CONCAT || c == PLUS || c == OPTIONAL;
 }
 
 int precedence(char c) {
-    if (c == STAR) return 3;
+    if (c == STAR || c == PLUS || c == OPTIONAL) return 3;
     if (c == CONCAT) return 2;
     if (c == UNION) return 1;
     return 0;
 }
 
+// Bytes matched by the escape \c: \d, \w, \s, \n, \t and \r are classes or
+// control characters, any other character stands for itself.
+ByteSet escapeBytes(char c) {
+    ByteSet set;
+    auto range = [&](int lo, int hi) { for (int b = lo; b <= hi; ++b) set.set(b); };
+    switch (c) {
+        case 'd': range('0', '9'); break;
+        case 'w': range('a', 'z'); range('A', 'Z'); range('0', '9'); set.set('_'); break;
+        case 's': for (char w : string(" \t\n\r\f\v")) set.set((unsigned char)w); break;
+        case 'n': set.set('\n'); break;
+        case 't': set.set('\t'); break;
+        case 'r': set.set('\r'); break;
+        default: set.set((unsigned char)c);
+    }
+    return set;
+}
+
+// Splits a regex into tokens. Besides | * ( ) and the end marker '#', it
+// accepts + and ?, '.' for any byte but a line break, backslash escapes and
+// bracket classes such as [a-zA-Z_] or [^"]. Any other character matches
+// itself.
+vector<RegexToken> tokenizeRegex(const string& regex) {
+    vector<RegexToken> tokens;
+    const size_t n = regex.size();
+    for (size_t i = 0; i < n; ++i) {
+        char c = regex[i];
+        RegexToken t = {0, ByteSet(), -1, string(1, c)};
+        if (c == UNION || c == STAR || c == PLUS || c == OPTIONAL || c == '(' || c == ')') {
+            t.op = c;
+        } else if (c == '#') {
+            t.token = 0;
+        } else if (c == '.') {
+            t.bytes.set();
+            t.bytes.reset('\n');
+            t.bytes.reset('\r');
+        } else if (c == '\\' && i + 1 < n) {
+            t.bytes = escapeBytes(regex[++i]);
+            t.text += regex[i];
+        } else if (c == '[') {
+            size_t j = i + 1;
+            bool negate = j < n && regex[j] == '^';
+            if (negate) ++j;
+            // A ']' first in the class is literal
+            for (bool first = true; j < n && (first || regex[j] != ']'); first = false) {
+                ByteSet item;
+                unsigned char lo = regex[j];
+                if (regex[j] == '\\' && j + 1 < n) {
+                    item = escapeBytes(regex[++j]);
+                    lo = regex[j];
+                } else {
+                    item.set(lo);
+                }
+                ++j;
+                if (item.count() == 1 && j + 1 < n && regex[j] == '-' && regex[j + 1] != ']') {
+                    unsigned char hi = regex[j + 1];
+                    for (int b = lo; b <= hi; ++b) item.set(b);
+                    j += 2;
+                }
+                t.bytes |= item;
+            }
+            if (negate) t.bytes.flip();
+            t.text = regex.substr(i, min(j + 1, n) - i);
+            i = j;
+        } else {
+            t.bytes.set((unsigned char)c);
+        }
+        tokens.push_back(t);
+    }
+    return tokens;
+}
+
 // Add explicit concatenation operator
-string addConcat(string regex) {
-    string res = "";
-    for (size_t i = 0; i < regex.length(); ++i) {
-        char c1 = regex[i];
-        res += c1;
-        if (i + 1 < regex.length()) {
-            char c2 = regex[i + 1];
-            if ((isalnum(c1) || c1 == '#' || c1 == '*' || c1 == ')') &&
-                (isalnum(c2) || c2 == '#' || c2 == '(')) {
-                res += CONCAT;
+vector<RegexToken> addConcat(const vector<RegexToken>& tokens) {
+    vector<RegexToken> res;
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        char c1 = tokens[i].op;
+        res.push_back(tokens[i]);
+        if (i + 1 < tokens.size()) {
+            char c2 = tokens[i + 1].op;
+            if ((c1 == 0 || c1 == STAR || c1 == PLUS || c1 == OPTIONAL || c1 == ')') &&
+                (c2 == 0 || c2 == '(')) {
+                res.push_back({CONCAT, ByteSet(), -1, string(1, CONCAT)});
             }
         }
     }
@@ -63,136 +277,178 @@ string addConcat(string regex) {
 }
 
 // Convert infix to postfix
-string toPostfix(string regex) {
-    regex = addConcat(regex);
-    stack<char> op;
-    string output = "";
-
-    for (char c : regex) {
-        if (isalnum(c) || c == '#') {
-            output += c;
-        } else if (c == '(') {
-            op.push(c);
-        } else if (c == ')') {
-            while (!op.empty() && op.top() != '(') {
-                output += op.top(); op.pop();
+vector<RegexToken> toPostfix(const string& regex) {
+    stack<RegexToken> op;
+    vector<RegexToken> output;
+
+    for (const RegexToken& t : addConcat(tokenizeRegex(regex))) {
+        if (t.op == 0) {
+            output.push_back(t);
+        } else if (t.op == '(') {
+            op.push(t);
+        } else if (t.op == ')') {
+            while (!op.empty() && op.top().op != '(') {
+                output.push_back(op.top()); op.pop();
             }
             if (!op.empty()) op.pop();
+            else output.push_back(t); // unmatched, left for countSubtrees to reject
         } else {
-            while (!op.empty() && precedence(op.top()) >= precedence(c)) {
-                output += op.top(); op.pop();
+            while (!op.empty() && precedence(op.top().op) >= precedence(t.op)) {
+                output.push_back(op.top()); op.pop();
             }
-            op.push(c);
+            op.push(t);
         }
     }
     while (!op.empty()) {
-        output += op.top(); op.pop();
+        output.push_back(op.top()); op.pop();
     }
     return output;
 }
 
-// Build Syntax Tree
-Node* buildSyntaxTree(string postfix) {
-    stack<Node*> st;
-
-    for (char c : postfix) {
-        if (isalnum(c) || c == '#') {
-            Node* node = new Node(c);
-            node->pos = positionCounter++;
-            positionNodes.push_back(node);
-            positionsOfSymbol[c].insert(node->pos);
-            st.push(node);
-        } else if (c == STAR) {
-            Node* child = st.top(); st.pop();
-            Node* node = new Node(c);
-            node->left = child;
-            st.push(node);
-        } else if (c == UNION || c == CONCAT) {
-            Node* right = st.top(); st.pop();
-            Node* left = st.top(); st.pop();
-            Node* node = new Node(c);
-            node->left = left;
-            node->right = right;
-            st.push(node);
+// Number of trees a postfix regex leaves on the stack: 1 for a regex, 0 if
+// it is empty, or -1 if an operator lacks operands or a parenthesis is
+// unmatched. buildSyntaxTree needs exactly one.
+int countSubtrees(const vector<RegexToken>& postfix) {
+    int depth = 0;
+    for (const RegexToken& t : postfix) {
+        if (t.op == 0) ++depth;
+        else if (t.op == STAR || t.op == PLUS || t.op == OPTIONAL) {
+            if (depth < 1) return -1;
+        } else if (t.op == UNION || t.op == CONCAT) {
+            if (depth < 2) return -1;
+            --depth;
+        } else {
+            return -1;
         }
     }
-    return st.top();
+    return depth;
 }
 
-// Compute nullable, firstpos, lastpos
-void computeNullableFirstLast(Node* node) {
-    if (!node) return;
-    if (!node->left && !node->right) {
-        node->nullable = (node->symbol == 'ε'); // If you're using Greek epsilon symbol
-        if (!node->nullable) {
-            node->firstpos.insert(node->pos);
-            node->lastpos.insert(node->pos);
-        }
-        return;
-    }
-
-    computeNullableFirstLast(node->left);
-    computeNullableFirstLast(node->right);
-
-    if (node->symbol == UNION) {
-        node->nullable = node->left->nullable || node->right->nullable;
-        node->firstpos.insert(node->left->firstpos.begin(), node->left->firstpos.end());
-        node->firstpos.insert(node->right->firstpos.begin(), node->right->firstpos.end());
-        node->lastpos.insert(node->left->lastpos.begin(), node->left->lastpos.end());
-        node->lastpos.insert(node->right->lastpos.begin(), node->right->lastpos.end());
-    } else if (node->symbol == CONCAT) {
-        node->nullable = node->left->nullable && node->right->nullable;
-        if (node->left->nullable) {
-            node->firstpos.insert(node->left->firstpos.begin(), node->left->firstpos.end());
-            node->firstpos.insert(node->right->firstpos.begin(), node->right->firstpos.end());
+// Build Syntax Tree; returns the root's index in the arena.
+int buildSyntaxTree(const vector<RegexToken>& postfix) {
+    stack<int> st;
+
+    for (const RegexToken& t : postfix) {
+        if (t.op == 0) {
+            Node node(0); // '.' as a leaf must not read as CONCAT
+            node.pos = positionCounter++;
+            node.bytes = t.bytes;
+            node.token = t.token;
+            node.label = t.text;
+            positionNodes.push_back(syntaxTree.size());
+            if (t.token >= 0) endMarkers.add(node.pos, t.token);
+            syntaxTree.push_back(node);
+        } else if (t.op == STAR || t.op == PLUS || t.op == OPTIONAL) {
+            int child = st.top(); st.pop();
+            syntaxTree.emplace_back(t.op, child);
+        } else if (t.op == UNION || t.op == CONCAT) {
+            int right = st.top(); st.pop();
+            int left = st.top(); st.pop();
+            syntaxTree.emplace_back(t.op, left, right);
         } else {
-            node->firstpos = node->left->firstpos;
+            continue;
         }
+        st.push(syntaxTree.size() - 1);
+    }
+    return st.top();
+}
 
-        if (node->right->nullable) {
-            node->lastpos.insert(node->left->lastpos.begin(), node->left->lastpos.end());
-            node->lastpos.insert(node->right->lastpos.begin(), node->right->lastpos.end());
-        } else {
-            node->lastpos = node->right->lastpos;
+// Calls f(node) for every node under root, children before their parent.
+// The pending nodes are kept on an explicit stack, so a tree as deep as a
+// 100k-character concatenation cannot overflow the call stack.
+template <typename F>
+void forEachPostorder(int root, F&& f) {
+    vector<pair<int, bool>> pending = {{root, false}};
+    while (!pending.empty()) {
+        auto [i, childrenDone] = pending.back();
+        pending.pop_back();
+        if (childrenDone) {
+            f(syntaxTree[i]);
+            continue;
         }
-    } else if (node->symbol == STAR) {
-        node->nullable = true;
-        node->firstpos = node->left->firstpos;
-        node->lastpos = node->left->lastpos;
+        pending.push_back({i, true});
+        if (syntaxTree[i].right >= 0) pending.push_back({syntaxTree[i].right, false});
+        if (syntaxTree[i].left >= 0) pending.push_back({syntaxTree[i].left, false});
     }
 }
 
-// Compute followpos
-void computeFollowpos(Node* node) {
-    if (!node) return;
-    computeFollowpos(node->left);
-    computeFollowpos(node->right);
+// Compute nullable, firstpos, lastpos
+void computeNullableFirstLast(int root) {
+    forEachPostorder(root, [](Node& node) {
+        if (node.left < 0 && node.right < 0) {
+            node.nullable = (node.symbol == 'ε'); // If you're using Greek epsilon symbol
+            if (!node.nullable) {
+                node.firstpos.insert(node.pos);
+                node.lastpos.insert(node.pos);
+            }
+            return;
+        }
 
-    if (node->symbol == CONCAT) {
-        for (int i : node->left->lastpos) {
-            followposMap[i].insert(node->right->firstpos.begin(), node->right->firstpos.end());
+        const Node& left = syntaxTree[node.left];
+        if (node.symbol == UNION) {
+            const Node& right = syntaxTree[node.right];
+            node.nullable = left.nullable || right.nullable;
+            node.firstpos = left.firstpos;
+            node.firstpos |= right.firstpos;
+            node.lastpos = left.lastpos;
+            node.lastpos |= right.lastpos;
+        } else if (node.symbol == CONCAT) {
+            const Node& right = syntaxTree[node.right];
+            node.nullable = left.nullable && right.nullable;
+            if (left.nullable) {
+                node.firstpos = left.firstpos;
+                node.firstpos |= right.firstpos;
+            } else {
+                node.firstpos = left.firstpos;
+            }
+
+            if (right.nullable) {
+                node.lastpos = left.lastpos;
+                node.lastpos |= right.lastpos;
+            } else {
+                node.lastpos = right.lastpos;
+            }
+        } else if (node.symbol == STAR || node.symbol == OPTIONAL) {
+            node.nullable = true;
+            node.firstpos = left.firstpos;
+            node.lastpos = left.lastpos;
+        } else if (node.symbol == PLUS) {
+            node.nullable = left.nullable;
+            node.firstpos = left.firstpos;
+            node.lastpos = left.lastpos;
         }
-    } else if (node->symbol == STAR) {
-        for (int i : node->lastpos) {
-            followposMap[i].insert(node->firstpos.begin(), node->firstpos.end());
+    });
+}
+
+// Compute followpos
+void computeFollowpos(int root) {
+    followposMap.resize(positionCounter);
+    forEachPostorder(root, [](const Node& node) {
+        if (node.symbol == CONCAT) {
+            const PositionSet& first = syntaxTree[node.right].firstpos;
+            syntaxTree[node.left].lastpos.forEach([&](int i) { followposMap[i] |= first; });
+        } else if (node.symbol == STAR || node.symbol == PLUS) {
+            node.lastpos.forEach([&](int i) { followposMap[i] |= node.firstpos; });
         }
-    }
+    });
 }
 
 // Format a set as string
-string formatSet(const set<int>& s) {
+string formatSet(const PositionSet& s) {
     stringstream ss;
     ss << "{";
-    for (auto it = s.begin(); it != s.end(); ++it) {
-        ss << *it;
-        if (next(it) != s.end()) ss << ",";
-    }
+    bool first = true;
+    s.forEach([&](int p) {
+        if (!first) ss << ",";
+        ss << p;
+        first = false;
+    });
     ss << "}";
     return ss.str();
 }
 
 // Print node info table
-void printNodeTable(const vector<Node*>& nodes) {
+void printNodeTable(const vector<int>& nodes) {
     cout << "\n=== Syntax Tree Node Table ===\n";
     cout << left << setw(10) << "Symbol"
          << setw(10) << "Pos"
@@ -201,8 +457,9 @@ void printNodeTable(const vector<Node*>& nodes) {
          << setw(18) << "Lastpos" << "\n";
     cout << string(68, '-') << "\n";
 
-    for (const Node* n : nodes) {
-        cout << left << setw(10) << n->symbol
+    for (int i : nodes) {
+        const Node* n = &syntaxTree[i];
+        cout << left << setw(10) << n->label
              << setw(10) << n->pos
              << setw(12) << (n->nullable ? "true" : "false")
              << setw(18) << formatSet(n->firstpos)
@@ -211,27 +468,956 @@ void printNodeTable(const vector<Node*>& nodes) {
 }
 
 // Print followpos table
-void printFollowposTable(const map<int, set<int>>& fmap) {
+void printFollowposTable(const vector<PositionSet>& fmap) {
     cout << "\n=== Followpos Table ===\n";
     cout << left << setw(15) << "Position" << "Followpos\n";
     cout << string(35, '-') << "\n";
-    for (map<int, set<int>>::const_iterator it = fmap.begin(); it != fmap.end(); ++it) {
-    int pos = it->first;
-    const set<int>& follow = it->second;
-    cout << left << setw(15) << pos << formatSet(follow) << "\n";
+    for (size_t pos = 0; pos < fmap.size(); ++pos) {
+        if (fmap[pos].empty()) continue;
+        cout << left << setw(15) << pos << formatSet(fmap[pos]) << "\n";
+    }
+}
+
+// Clears the positions and followpos of the previous regex.
+void resetPositions() {
+    positionCounter = 1;
+    followposMap.clear();
+    positionsOfSymbol.clear();
+    endMarkers = EndMarkers();
+    symbolLabels.clear();
+    syntaxTree.clear();
+    positionNodes.clear();
 }
 
+// Spells a byte set compactly, with runs of three or more as ranges.
+string describeBytes(ByteSet bytes) {
+    string out;
+    bool negated = bytes.count() > 128;
+    if (negated) bytes.flip();
+    auto spell = [](int b) {
+        if (b > ' ' && b < 127) return string(1, char(b));
+        char buf[16];
+        snprintf(buf, sizeof buf, "\\x%02X", b);
+        return string(buf);
+    };
+    for (int b = 0; b < 256; ++b) {
+        if (!bytes[b]) continue;
+        int e = b;
+        while (e + 1 < 256 && bytes[e + 1]) ++e;
+        out += spell(b);
+        if (e - b >= 2) out += "-" + spell(e);
+        else if (e > b) out += spell(e);
+        b = e;
+    }
+    if (negated) return "[^" + out + "]";
+    return bytes.count() == 1 ? out : "[" + out + "]";
 }
 
-int main() {
+// Splits the 256 byte values into the classes no leaf tells apart: two
+// bytes share a class when every leaf matches both or neither. Each class
+// some leaf matches becomes one input symbol of the DFA, numbered by its
+// smallest byte; bytes no leaf matches have no symbol.
+void computeInputSymbols() {
+    array<int, 256> cls;
+    cls.fill(0);
+    int classCount = 1;
+    ByteSet used;
+    unordered_set<ByteSet> seen;
+    for (int i : positionNodes) {
+        const Node* leaf = &syntaxTree[i];
+        if (leaf->token >= 0 || !seen.insert(leaf->bytes).second) continue;
+        used |= leaf->bytes;
+        // Bytes of the leaf move to a new class next to their old one
+        vector<int> split(classCount, -1);
+        int fresh = classCount;
+        for (int b = 0; b < 256; ++b) {
+            if (!leaf->bytes[b]) continue;
+            int& to = split[cls[b]];
+            if (to < 0) to = fresh++;
+            cls[b] = to;
+        }
+        // Renumber so ids stay below 256
+        vector<int> id(fresh, -1);
+        classCount = 0;
+        for (int b = 0; b < 256; ++b) {
+            if (id[cls[b]] < 0) id[cls[b]] = classCount++;
+            cls[b] = id[cls[b]];
+        }
+    }
+
+    vector<int> symbolOfClass(classCount, -1);
+    vector<ByteSet> members;
+    symbolOf.fill(-1);
+    for (int b = 0; b < 256; ++b) {
+        if (!used[b]) continue;
+        int& sym = symbolOfClass[cls[b]];
+        if (sym < 0) {
+            sym = members.size();
+            members.emplace_back();
+        }
+        members[sym].set(b);
+        symbolOf[b] = sym;
+    }
+    for (const ByteSet& m : members) symbolLabels.push_back(describeBytes(m));
+
+    positionsOfSymbol.assign(members.size(), PositionSet());
+    vector<char> hit(members.size());
+    for (int i : positionNodes) {
+        const Node* leaf = &syntaxTree[i];
+        if (leaf->token >= 0) continue;
+        fill(hit.begin(), hit.end(), 0);
+        for (int b = 0; b < 256; ++b)
+            if (leaf->bytes[b]) hit[symbolOf[b]] = 1;
+        for (size_t sym = 0; sym < hit.size(); ++sym)
+            if (hit[sym]) positionsOfSymbol[sym].insert(leaf->pos);
+    }
+}
+
+// DFA from the direct construction: each state is a set of positions,
+// state 0 is the root's firstpos, and the transition on symbol a from S is the
+// union of followpos(p) over the positions p in S whose leaf matches a.
+// The input symbols are the byte classes of computeInputSymbols, so [a-z]
+// is one column, not 26. Transitions form a dense state x symbol table; -1
+// is the dead state. A state holding end markers of several tokens accepts
+// the one with the highest priority.
+struct DFA {
+    vector<string> alphabet;      // one table column per input symbol
+    array<int, 256> column;       // byte -> column, or -1 if not in the alphabet
+    vector<int> transitions;      // stateCount() * alphabet.size() entries
+    vector<int> acceptToken;      // token the state accepts, or -1
+    vector<PositionSet> positions; // positions making up each state
+
+    int stateCount() const { return acceptToken.size(); }
+
+    int next(int state, unsigned char c) const {
+        int col = column[c];
+        return col < 0 ? -1 : transitions[state * alphabet.size() + col];
+    }
+};
+
+DFA buildDFA(int root) {
+    DFA dfa;
+    dfa.column = symbolOf;
+    dfa.alphabet = symbolLabels;
+    const size_t k = dfa.alphabet.size();
+
+    unordered_map<PositionSet, int, PositionSetHash> stateOf;
+    auto addState = [&](const PositionSet& S) {
+        auto it = stateOf.find(S);
+        if (it != stateOf.end()) return it->second;
+        int id = dfa.positions.size();
+        stateOf.emplace(S, id);
+        dfa.positions.push_back(S);
+        dfa.acceptToken.push_back(endMarkers.acceptedToken(S));
+        dfa.transitions.resize(dfa.transitions.size() + k, -1);
+        return id;
+    };
+
+    addState(syntaxTree[root].firstpos);
+    // States are numbered in discovery order, so this loop is the worklist
+    for (size_t s = 0; s < dfa.positions.size(); ++s) {
+        for (size_t col = 0; col < k; ++col) {
+            PositionSet here = dfa.positions[s] & positionsOfSymbol[col];
+            PositionSet U;
+            here.forEach([&](int p) { U |= followposMap[p]; });
+            if (!U.empty()) {
+                int target = addState(U);
+                dfa.transitions[s * k + col] = target;
+            }
+        }
+    }
+    return dfa;
+}
+
+// Hopcroft's partition refinement. Missing transitions go to an explicit
+// sink state so the automaton is complete. Blocks start as the states
+// accepting each token plus the non-accepting ones, and each splitter block taken from the worklist splits
+// every block that its preimage (per symbol) cuts in two. A split block
+// already on the worklist queues its new half; otherwise only the smaller
+// half is queued, so each state is re-queued O(log n) times: O(n k log n).
+DFA minimizeDFA(const DFA& dfa) {
+    const int n = dfa.stateCount() + 1, sink = n - 1;
+    const size_t k = dfa.alphabet.size();
+    auto target = [&](int s, size_t col) {
+        int t = s == sink ? -1 : dfa.transitions[s * k + col];
+        return t < 0 ? sink : t;
+    };
+
+    // Predecessors of each state per symbol, as one CSR array per symbol
+    vector<vector<int>> predStart(k, vector<int>(n + 1, 0)), preds(k, vector<int>(n));
+    for (size_t col = 0; col < k; ++col) {
+        for (int s = 0; s < n; ++s) ++predStart[col][target(s, col) + 1];
+        for (int t = 0; t < n; ++t) predStart[col][t + 1] += predStart[col][t];
+        vector<int> fill(predStart[col].begin(), predStart[col].end() - 1);
+        for (int s = 0; s < n; ++s) preds[col][fill[target(s, col)]++] = s;
+    }
+
+    // Refinable partition: each block is a range of elems, with the states
+    // marked by the current splitter moved to the front of their block
+    vector<int> elems(n), location(n), blockOf(n);
+    vector<int> blockStart, blockEnd, marked;
+    vector<char> inWorklist;
+    vector<int> worklist;
+    auto tokenOf = [&](int s) { return s == sink ? -1 : dfa.acceptToken[s]; };
+    set<int> tokens;
+    for (int s = 0; s < n; ++s) tokens.insert(tokenOf(s));
+    int next = 0;
+    for (int token : tokens) {
+        int start = next;
+        for (int s = 0; s < n; ++s) {
+            if (tokenOf(s) != token) continue;
+            elems[next] = s;
+            location[s] = next++;
+            blockOf[s] = blockStart.size();
+        }
+        blockStart.push_back(start);
+        blockEnd.push_back(next);
+        marked.push_back(0);
+        inWorklist.push_back(0);
+    }
+    // Every initial block but the largest is a splitter
+    int largest = 0;
+    for (size_t b = 1; b < blockStart.size(); ++b)
+        if (blockEnd[b] - blockStart[b] > blockEnd[largest] - blockStart[largest]) largest = b;
+    for (size_t b = 0; b < blockStart.size(); ++b) {
+        if ((int)b == largest) continue;
+        worklist.push_back(b);
+        inWorklist[b] = 1;
+    }
+
+    vector<int> splitter, touched;
+    while (!worklist.empty()) {
+        int a = worklist.back();
+        worklist.pop_back();
+        inWorklist[a] = 0;
+        splitter.assign(elems.begin() + blockStart[a], elems.begin() + blockEnd[a]);
+
+        for (size_t col = 0; col < k; ++col) {
+            touched.clear();
+            for (int t : splitter) {
+                for (int i = predStart[col][t]; i < predStart[col][t + 1]; ++i) {
+                    int s = preds[col][i], b = blockOf[s];
+                    int front = blockStart[b] + marked[b];
+                    if (location[s] < front) continue; // already marked
+                    if (marked[b]++ == 0) touched.push_back(b);
+                    int other = elems[front];
+                    swap(elems[front], elems[location[s]]);
+                    location[other] = location[s];
+                    location[s] = front;
+                }
+            }
+            for (int b : touched) {
+                int count = marked[b];
+                marked[b] = 0;
+                if (count == blockEnd[b] - blockStart[b]) continue;
+                // The marked front part becomes a new block
+                int nb = blockStart.size();
+                blockStart.push_back(blockStart[b]);
+                blockEnd.push_back(blockStart[b] + count);
+                marked.push_back(0);
+                inWorklist.push_back(0);
+                blockStart[b] += count;
+                for (int i = blockStart[nb]; i < blockEnd[nb]; ++i) blockOf[elems[i]] = nb;
+                int queued = inWorklist[b] || count <= blockEnd[b] - blockStart[b] ? nb : b;
+                if (!inWorklist[queued]) {
+                    worklist.push_back(queued);
+                    inWorklist[queued] = 1;
+                }
+            }
+        }
+    }
+
+    // Number blocks in breadth-first order from the start state; the sink's
+    // block is the dead state
+    vector<int> newState(blockStart.size(), -1);
+    vector<int> order = {blockOf[0]};
+    newState[blockOf[0]] = 0;
+    for (size_t i = 0; i < order.size(); ++i) {
+        int rep = elems[blockStart[order[i]]];
+        for (size_t col = 0; col < k; ++col) {
+            int b = blockOf[target(rep, col)];
+            if (b != blockOf[sink] && newState[b] < 0) {
+                newState[b] = order.size();
+                order.push_back(b);
+            }
+        }
+    }
+    if (order[0] == blockOf[sink]) order.clear(); // the language is empty
+
+    DFA min;
+    min.alphabet = dfa.alphabet;
+    min.column = dfa.column;
+    min.transitions.assign(max<size_t>(order.size(), 1) * k, -1);
+    min.acceptToken.assign(max<size_t>(order.size(), 1), -1);
+    min.positions.resize(max<size_t>(order.size(), 1));
+    for (size_t i = 0; i < order.size(); ++i) {
+        int b = order[i];
+        for (int e = blockStart[b]; e < blockEnd[b]; ++e) min.positions[i] |= dfa.positions[elems[e]];
+        int rep = elems[blockStart[b]];
+        min.acceptToken[i] = dfa.acceptToken[rep];
+        for (size_t col = 0; col < k; ++col) {
+            int t = blockOf[target(rep, col)];
+            min.transitions[i * k + col] = t == blockOf[sink] ? -1 : newState[t];
+        }
+    }
+    return min;
+}
+
+struct MatchResult {
+    bool matched;
+    size_t length; // length of the longest accepted prefix
+    int token;     // token accepting that prefix
+};
+
+// Runs the DFA over input and reports the longest prefix it accepts.
+MatchResult longestMatch(const DFA& dfa, string_view input) {
+    MatchResult result = {dfa.acceptToken[0] >= 0, 0, dfa.acceptToken[0]};
+    int state = 0;
+    for (size_t i = 0; i < input.size(); ++i) {
+        state = dfa.next(state, input[i]);
+        if (state < 0) break;
+        if (dfa.acceptToken[state] >= 0) result = {true, i + 1, dfa.acceptToken[state]};
+    }
+    return result;
+}
+
+// Matcher runtime for a DFA. Bytes map to equivalence classes (bytes whose
+// columns agree in every state share one), and transitions are a flat
+// uint16_t array, small enough to stay in cache for lexer-sized automata.
+// Rows are padded to a power of two so finding one is a shift, not a
+// multiply, on the path from one state to the next. Row 0 is the dead state
+// and loops to itself, and accepting states are numbered last, so testing
+// for one is a compare rather than another load.
+struct CompactMatcher {
+    array<uint16_t, 256> classOf; // up to 256 byte classes plus the dead class
+    size_t classCount;
+    unsigned rowShift;          // log2 of the padded row width
+    vector<uint16_t> table;     // stateCount() << rowShift entries
+    vector<uint16_t> accepting; // token + 1 per state, 0 if not accepting
+    uint16_t start;
+    uint16_t firstAccepting;    // states from here on accept
+
+    int stateCount() const { return accepting.size(); }
+    size_t memoryUsage() const {
+        return sizeof(*this) + (table.capacity() + accepting.capacity()) * sizeof(uint16_t);
+    }
+};
+
+// Fails if the DFA has too many states for 16-bit state numbers.
+bool compileMatcher(const DFA& dfa, CompactMatcher& m) {
+    const size_t k = dfa.alphabet.size();
+    if (dfa.stateCount() + 1 > 65536) return false;
+
+    // Class 0 holds the bytes outside the alphabet, whose column is all dead
+    map<vector<int>, int> classOfColumn;
+    classOfColumn[vector<int>(dfa.stateCount(), -1)] = 0;
+    vector<int> classOfCol(k);
+    for (size_t col = 0; col < k; ++col) {
+        vector<int> targets(dfa.stateCount());
+        for (int s = 0; s < dfa.stateCount(); ++s) targets[s] = dfa.transitions[s * k + col];
+        classOfCol[col] = classOfColumn.emplace(targets, (int)classOfColumn.size()).first->second;
+    }
+    for (int b = 0; b < 256; ++b) m.classOf[b] = dfa.column[b] < 0 ? 0 : classOfCol[dfa.column[b]];
+    m.classCount = classOfColumn.size();
+
+    // Rows: the dead state, then the non-accepting states, then the accepting
+    vector<int> row(dfa.stateCount());
+    int next = 1;
+    for (bool accepts : {false, true}) {
+        if (accepts) m.firstAccepting = next;
+        for (int s = 0; s < dfa.stateCount(); ++s)
+            if ((dfa.acceptToken[s] >= 0) == accepts) row[s] = next++;
+    }
+    m.rowShift = 0;
+    while ((size_t(1) << m.rowShift) < m.classCount) ++m.rowShift;
+    m.start = row[0];
+    m.table.assign(size_t(dfa.stateCount() + 1) << m.rowShift, 0);
+    m.accepting.assign(dfa.stateCount() + 1, 0);
+    for (int s = 0; s < dfa.stateCount(); ++s) {
+        m.accepting[row[s]] = dfa.acceptToken[s] + 1;
+        for (size_t col = 0; col < k; ++col) {
+            int t = dfa.transitions[s * k + col];
+            m.table[(size_t(row[s]) << m.rowShift) + classOfCol[col]] = t < 0 ? 0 : row[t];
+        }
+    }
+    return true;
+}
+
+// Longest accepted prefix. Reaching the dead state ends the scan; that test
+// is almost never taken, so the accept check, which compiles to a
+// conditional move, is the only data-dependent branch. The token is looked
+// up once, for the last accepting state seen.
+MatchResult longestMatch(const CompactMatcher& m, string_view input) {
+    const uint16_t* table = m.table.data();
+    const uint16_t* classOf = m.classOf.data();
+    const unsigned shift = m.rowShift, firstAccepting = m.firstAccepting;
+    size_t state = m.start;
+    size_t length = 0, last = state >= firstAccepting ? state : 0;
+    for (size_t i = 0; i < input.size(); ++i) {
+        state = table[(state << shift) + classOf[(unsigned char)input[i]]];
+        if (state == 0) break;
+        if (state >= firstAccepting) {
+            length = i + 1;
+            last = state;
+        }
+    }
+    unsigned token = m.accepting[last];
+    return {token != 0, length, (int)token - 1};
+}
+
+// DFA built on demand: a state is made from followpos sets the first time
+// the input reaches it, and each transition is computed once and then read
+// from a dense table like the eager DFA's. The states live in a cache with
+// a byte budget; adding a state that would exceed it first flushes the
+// whole cache, so matching memory stays bounded even for regexes whose full
+// DFA is exponential, and the flush count shows how often that happened.
+// The tables of the last compiled regex are copied in, so later compiles
+// do not affect it.
+class LazyDFA {
+public:
+    LazyDFA(int root, size_t budgetBytes)
+        : start(syntaxTree[root].firstpos), followpos(followposMap), symbolPositions(positionsOfSymbol),
+          markers(endMarkers), column(symbolOf), k(positionsOfSymbol.size()), budget(budgetBytes) {}
+
+    MatchResult longestMatch(string_view input) {
+        if (startState < 0) startState = stateFor(start);
+        int state = startState;
+        MatchResult result = {acceptToken[state] >= 0, 0, acceptToken[state]};
+        for (size_t i = 0; i < input.size(); ++i) {
+            int col = column[(unsigned char)input[i]];
+            if (col < 0) break;
+            int next = transitions[state * k + col];
+            if (next == UNKNOWN) next = computeTransition(state, col);
+            if (next == DEAD) break;
+            state = next;
+            if (acceptToken[state] >= 0) result = {true, i + 1, acceptToken[state]};
+        }
+        return result;
+    }
+
+    int stateCount() const { return acceptToken.size(); }
+    size_t flushCount() const { return flushes; }
+    size_t statesBuilt() const { return built; }
+    size_t memoryUsage() const { return used; }
+
+private:
+    static constexpr int UNKNOWN = -2, DEAD = -1;
+
+    PositionSet start;
+    vector<PositionSet> followpos;
+    vector<PositionSet> symbolPositions;
+    EndMarkers markers;
+    array<int, 256> column;
+    size_t k;
+    size_t budget, used = 0;
+    size_t flushes = 0, built = 0;
+
+    int startState = -1;
+    unordered_map<PositionSet, int, PositionSetHash> stateOf;
+    vector<const PositionSet*> positions; // keys of stateOf
+    vector<int> transitions;              // stateCount() * k, UNKNOWN until computed
+    vector<int> acceptToken;
+
+    size_t stateBytes(const PositionSet& S) const {
+        // the set, its hash node, and the state's row
+        return sizeof(PositionSet) + S.memoryUsage() + 4 * sizeof(void*) + k * sizeof(int) + sizeof(int);
+    }
+
+    int stateFor(const PositionSet& S) {
+        auto it = stateOf.find(S);
+        if (it != stateOf.end()) return it->second;
+        if (used + stateBytes(S) > budget && !positions.empty()) flush();
+        int id = positions.size();
+        positions.push_back(&stateOf.emplace(S, id).first->first);
+        transitions.resize(transitions.size() + k, UNKNOWN);
+        acceptToken.push_back(markers.acceptedToken(S));
+        used += stateBytes(S);
+        ++built;
+        return id;
+    }
+
+    void flush() {
+        stateOf.clear();
+        positions.clear();
+        transitions.clear();
+        acceptToken.clear();
+        startState = -1;
+        used = 0;
+        ++flushes;
+    }
+
+    int computeTransition(int state, int col) {
+        PositionSet U;
+        (*positions[state] & symbolPositions[col]).forEach([&](int p) { U |= followpos[p]; });
+        if (U.empty()) return transitions[state * k + col] = DEAD;
+        size_t flushesBefore = flushes;
+        int target = stateFor(U);
+        // After a flush the source state is gone and the edge is not cached
+        if (flushes == flushesBefore) transitions[state * k + col] = target;
+        return target;
+    }
+};
+
+// Print DFA transition table
+void printDFATable(const DFA& dfa) {
+    cout << "\n=== DFA Transition Table ===\n";
+    vector<int> width;
+    for (const string& label : dfa.alphabet) width.push_back(max<int>(8, label.size() + 2));
+    cout << left << setw(8) << "State" << setw(8) << "Accept";
+    for (size_t col = 0; col < dfa.alphabet.size(); ++col) cout << setw(width[col]) << dfa.alphabet[col];
+    cout << "Positions\n";
+    cout << string(16 + accumulate(width.begin(), width.end(), 0) + 12, '-') << "\n";
+    for (int s = 0; s < dfa.stateCount(); ++s) {
+        string accept = dfa.acceptToken[s] < 0 ? "" : endMarkers.priority.size() > 1 ? to_string(dfa.acceptToken[s]) : "yes";
+        cout << left << setw(8) << s << setw(8) << accept;
+        for (size_t col = 0; col < dfa.alphabet.size(); ++col) {
+            int t = dfa.transitions[s * dfa.alphabet.size() + col];
+            cout << setw(width[col]) << (t < 0 ? string("-") : to_string(t));
+        }
+        cout << formatSet(dfa.positions[s]) << "\n";
+    }
+}
+
+struct BuildTimes {
+    double followposMs, dfaMs;
+};
+
+// Parses a postfix regex whose end markers accept tokens of the given
+// priorities, and computes followpos and the input symbols.
+int buildFollowpos(const vector<RegexToken>& postfix, const vector<int>& priorities) {
+    resetPositions();
+    endMarkers.priority = priorities;
+    int root = buildSyntaxTree(postfix);
+    computeNullableFirstLast(root);
+    computeFollowpos(root);
+    computeInputSymbols();
+    return root;
+}
+
+// Builds the DFA of a postfix regex whose end markers accept tokens of the
+// given priorities, timing the two phases.
+DFA compilePostfix(const vector<RegexToken>& postfix, const vector<int>& priorities, BuildTimes& times,
+                   int* rootOut = nullptr) {
+    using Clock = chrono::steady_clock;
+    auto start = Clock::now();
+    int root = buildFollowpos(postfix, priorities);
+    auto mid = Clock::now();
+    DFA dfa = buildDFA(root);
+    auto end = Clock::now();
+    times.followposMs = chrono::duration<double, milli>(mid - start).count();
+    times.dfaMs = chrono::duration<double, milli>(end - mid).count();
+    if (rootOut) *rootOut = root;
+    return dfa;
+}
+
+// Parses regex, whose '#' accepts token 0, and builds its DFA.
+DFA compileRegex(const string& regex, BuildTimes& times, int* rootOut = nullptr) {
+    return compilePostfix(toPostfix(regex), {0}, times, rootOut);
+}
+
+// One line of a token spec: NAME PRIORITY REGEX. The regex is the rest of
+// the line and may contain spaces. Tokens named "skip" are matched but not
+// reported, for whitespace and comments.
+struct TokenPattern {
+    string name;
+    int priority;
+    string regex;
+};
+
+// Reads a token spec, ignoring blank lines and lines starting with "//".
+// Reports the first malformed line to errors and returns false.
+bool readTokenSpec(istream& in, vector<TokenPattern>& patterns, ostream& errors) {
+    string line;
+    for (int lineNo = 1; getline(in, line); ++lineNo) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        size_t first = line.find_first_not_of(" \t");
+        if (first == string::npos || line.compare(first, 2, "//") == 0) continue;
+        istringstream fields(line);
+        TokenPattern p;
+        if (!(fields >> p.name >> p.priority) || !getline(fields >> ws, p.regex)) p.regex.clear();
+        p.regex.erase(p.regex.find_last_not_of(" \t") + 1);
+        if (p.regex.empty()) {
+            errors << "line " << lineNo << ": expected NAME PRIORITY REGEX\n";
+            return false;
+        }
+        int trees = countSubtrees(toPostfix(p.regex));
+        if (trees < 0 || trees > 1) {
+            errors << "line " << lineNo << ": malformed regex\n";
+            return false;
+        }
+        patterns.push_back(p);
+    }
+    return true;
+}
+
+// One automaton for all patterns: (r1)#1 | (r2)#2 | ..., where #i is an end
+// marker accepting token i. The followpos construction keeps the patterns
+// apart, and a state reached by several accepts the highest priority one,
+// the earliest in the spec on a tie.
+DFA compileTokenSpec(const vector<TokenPattern>& patterns, BuildTimes& times) {
+    vector<RegexToken> postfix;
+    vector<int> priorities;
+    for (size_t i = 0; i < patterns.size(); ++i) {
+        vector<RegexToken> body = toPostfix(patterns[i].regex);
+        postfix.insert(postfix.end(), body.begin(), body.end());
+        postfix.push_back({0, ByteSet(), (int)i, "#" + to_string(i)});
+        if (!body.empty()) postfix.push_back({CONCAT, ByteSet(), -1, string(1, CONCAT)});
+        if (i > 0) postfix.push_back({UNION, ByteSet(), -1, string(1, UNION)});
+        priorities.push_back(patterns[i].priority);
+    }
+    return compilePostfix(postfix, priorities, times);
+}
+
+// Splits input into tokens by longest match: at each offset the longest
+// prefix that any pattern accepts becomes one token, of the best pattern
+// accepting exactly that prefix. A byte that starts no token is reported
+// alone as token -1. Calls emit(token, lexeme, offset).
+template <typename Matcher, typename F>
+void scanTokens(const Matcher& m, string_view input, F&& emit) {
+    for (size_t i = 0; i < input.size();) {
+        MatchResult r = longestMatch(m, input.substr(i));
+        size_t length = r.matched && r.length > 0 ? r.length : 1;
+        emit(r.matched && r.length > 0 ? r.token : -1, input.substr(i, length), i);
+        i += length;
+    }
+}
+
+// Compiles the spec at specPath and prints the tokens of inputPath (or of
+// standard input), one per line with its line number.
+int runTokenSpec(const string& specPath, const string& inputPath) {
+    ifstream spec(specPath);
+    if (!spec) {
+        cerr << "Cannot open " << specPath << "\n";
+        return 1;
+    }
+    vector<TokenPattern> patterns;
+    if (!readTokenSpec(spec, patterns, cerr)) return 1;
+    if (patterns.empty()) {
+        cerr << specPath << ": no token patterns\n";
+        return 1;
+    }
+
+    BuildTimes times;
+    DFA dfa = compileTokenSpec(patterns, times);
+    DFA min = minimizeDFA(dfa);
+    CompactMatcher matcher;
+    bool compact = compileMatcher(min, matcher);
+    cerr << patterns.size() << " patterns, " << positionNodes.size() << " positions, " << dfa.stateCount()
+         << " states, " << min.stateCount() << " minimized, built in " << fixed << setprecision(3)
+         << times.followposMs + times.dfaMs << " ms\n";
+
+    string text;
+    if (inputPath.empty()) {
+        text.assign(istreambuf_iterator<char>(cin), istreambuf_iterator<char>());
+    } else {
+        ifstream in(inputPath, ios::binary);
+        if (!in) {
+            cerr << "Cannot open " << inputPath << "\n";
+            return 1;
+        }
+        text.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    }
+
+    int lineNo = 1;
+    auto print = [&](int token, string_view lexeme, size_t) {
+        if (token < 0 || patterns[token].name != "skip")
+            cout << left << setw(8) << lineNo << setw(16) << (token < 0 ? "error" : patterns[token].name) << lexeme
+                 << "\n";
+        lineNo += count(lexeme.begin(), lexeme.end(), '\n');
+    };
+    if (compact) scanTokens(matcher, text, print);
+    else scanTokens(min, text, print);
+    return 0;
+}
+
+// Builds DFAs for generated regexes of growing size and reports positions,
+// states and construction time: alternations of random words (states grow
+// with the trie of the words) and (a|b)*a(a|b)^n, whose DFA needs 2^(n+1)
+// states.
+void runBenchmark() {
+    mt19937 rng(42);
+    auto word = [&]() {
+        string w;
+        for (int len = 3 + rng() % 8; len > 0; --len) w += char('a' + rng() % 26);
+        return w;
+    };
+    vector<pair<string, string>> cases;
+    for (int words : {50, 200, 1000, 2000, 5000}) {
+        string regex = "(";
+        for (int w = 0; w < words; ++w) regex += (w ? "|" : "") + word();
+        cases.push_back({to_string(words) + " words", regex + ")#"});
+    }
+    for (int n : {4, 8, 12}) {
+        string regex = "(a|b)*a";
+        for (int i = 0; i < n; ++i) regex += "(a|b)";
+        cases.push_back({"(a|b)*a(a|b)^" + to_string(n), regex + "#"});
+    }
+
+    cout << left << setw(22) << "Regex" << setw(12) << "Positions" << setw(10) << "States"
+         << setw(12) << "Minimal" << setw(16) << "Followpos ms" << setw(10) << "DFA ms" << "Minimize ms\n";
+    cout << string(94, '-') << "\n";
+    for (auto& c : cases) {
+        BuildTimes times;
+        DFA dfa = compileRegex(c.second, times);
+        auto minStart = chrono::steady_clock::now();
+        DFA min = minimizeDFA(dfa);
+        double minMs = chrono::duration<double, milli>(chrono::steady_clock::now() - minStart).count();
+        cout << left << setw(22) << c.first << setw(12) << positionNodes.size() << setw(10) << dfa.stateCount()
+             << setw(12) << min.stateCount() << setw(16) << fixed << setprecision(2) << times.followposMs
+             << setw(10) << times.dfaMs << minMs << "\n";
+    }
+}
+
+// Classifies tokens with the std::regex patterns of lex_analyzer.cpp, then
+// with DFAs built here from the same patterns, first through the int table
+// and then through compact matchers, and reports tokens/sec for each.
+// Tokens are the whitespace-separated words of path, or generated
+// identifiers, numbers, literals and junk when no path is given.
+void runMatchBenchmark(const string& path) {
+    using Clock = chrono::steady_clock;
+    const char* patterns[] = {"[a-zA-Z_][a-zA-Z0-9_]*", "[0-9]+", "[0-9]*\\.[0-9]+", "\".*\""};
+    const int patternCount = 4;
+
+    vector<string> tokens;
+    if (!path.empty()) {
+        ifstream in(path);
+        if (!in) {
+            cerr << "Cannot open " << path << "\n";
+            return;
+        }
+        string word;
+        while (in >> word) tokens.push_back(word);
+    } else {
+        mt19937 rng(7);
+        auto chars = [&](const char* set, int len) {
+            string w;
+            for (size_t n = strlen(set); len > 0; --len) w += set[rng() % n];
+            return w;
+        };
+        const char* alpha = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ_";
+        const char* digits = "0123456789";
+        for (int i = 0; i < 200000; ++i) {
+            switch (rng() % 6) {
+                case 0: case 1: tokens.push_back(chars(alpha, 1) + chars("abcxyz_019", rng() % 12)); break;
+                case 2: tokens.push_back(chars(digits, 1 + rng() % 6)); break;
+                case 3: tokens.push_back(chars(digits, rng() % 4) + "." + chars(digits, 1 + rng() % 4)); break;
+                case 4: tokens.push_back("\"" + chars("hello world %d\\n", rng() % 20) + "\""); break;
+                default: tokens.push_back(chars("0123456789abc.+-*\"", 1 + rng() % 5)); break;
+            }
+        }
+    }
+    if (tokens.empty()) return;
+
+    vector<regex> regexes;
+    vector<DFA> dfas;
+    vector<CompactMatcher> matchers(patternCount);
+    cout << left << setw(26) << "Pattern" << setw(10) << "States" << setw(10) << "Classes" << "Table bytes\n";
+    cout << string(58, '-') << "\n";
+    for (int i = 0; i < patternCount; ++i) {
+        regexes.emplace_back(string("^") + patterns[i] + "$");
+        BuildTimes times;
+        dfas.push_back(minimizeDFA(compileRegex(string("(") + patterns[i] + ")#", times)));
+        compileMatcher(dfas.back(), matchers[i]);
+        cout << left << setw(26) << patterns[i] << setw(10) << matchers[i].stateCount()
+             << setw(10) << matchers[i].classCount << matchers[i].memoryUsage() << "\n";
+    }
+    cout << "\n" << tokens.size() << " tokens\n";
+
+    // Kind is the first pattern matching the whole token, or patternCount
+    auto measure = [&](const char* name, auto&& kindOf) {
+        size_t count = 0, kindSum = 0;
+        auto start = Clock::now();
+        double elapsed = 0;
+        do {
+            for (const string& token : tokens) kindSum += kindOf(token);
+            count += tokens.size();
+            elapsed = chrono::duration<double>(Clock::now() - start).count();
+        } while (elapsed < 0.5);
+        double perSec = count / elapsed;
+        cout << left << setw(14) << name << fixed << setprecision(0) << perSec << " tokens/sec\n";
+        return make_pair(perSec, kindSum / (count / tokens.size()));
+    };
+    auto regexPath = measure("std::regex", [&](const string& token) {
+        int k = 0;
+        while (k < patternCount && !regex_match(token, regexes[k])) ++k;
+        return k;
+    });
+    auto dfaPath = measure("DFA", [&](const string& token) {
+        int k = 0;
+        while (k < patternCount && longestMatch(dfas[k], token).length != token.size()) ++k;
+        return k;
+    });
+    auto compactPath = measure("compact DFA", [&](const string& token) {
+        int k = 0;
+        while (k < patternCount && longestMatch(matchers[k], token).length != token.size()) ++k;
+        return k;
+    });
+    cout << "Speedup       : " << setprecision(1) << compactPath.first / regexPath.first << "x over std::regex, "
+         << compactPath.first / dfaPath.first << "x over the DFA table\n";
+    if (regexPath.second != compactPath.second || dfaPath.second != compactPath.second)
+        cerr << "Warning: matchers disagree on token classification\n";
+
+    // A large automaton, where table size decides how much stays in cache:
+    // an alternation of 5000 words, matched against words and near misses
+    mt19937 rng(42);
+    vector<string> words;
+    string regex = "(";
+    for (int w = 0; w < 5000; ++w) {
+        string word;
+        for (int len = 3 + rng() % 8; len > 0; --len) word += char('a' + rng() % 26);
+        regex += (w ? "|" : "") + word;
+        words.push_back(word);
+    }
+    BuildTimes times;
+    DFA big = minimizeDFA(compileRegex(regex + ")#", times));
+    CompactMatcher bigMatcher;
+    if (!compileMatcher(big, bigMatcher)) return;
+    tokens.clear();
+    for (int i = 0; i < 200000; ++i) {
+        string token = words[rng() % words.size()];
+        if (rng() % 2) token[rng() % token.size()] = 'a' + rng() % 26;
+        tokens.push_back(token);
+    }
+    cout << "\n5000-word alternation: " << big.stateCount() << " states, int table "
+         << big.transitions.size() * sizeof(int) << " bytes, compact table " << bigMatcher.memoryUsage() << " bytes\n";
+    auto bigDfa = measure("DFA", [&](const string& token) { return longestMatch(big, token).length == token.size(); });
+    auto bigCompact = measure("compact DFA", [&](const string& token) {
+        return longestMatch(bigMatcher, token).length == token.size();
+    });
+    cout << "Speedup       : " << setprecision(1) << bigCompact.first / bigDfa.first << "x over the DFA table\n";
+    if (bigDfa.second != bigCompact.second) cerr << "Warning: matchers disagree\n";
+
+    // Every byte its own class: byte b followed by b + 1 'a's, so the
+    // compact matcher needs all 256 byte classes besides the dead one
+    string wide = "(";
+    for (int b = 0; b < 256; ++b) {
+        if (b) wide += "|";
+        if (strchr("|*+?().#\\[", b) && b) wide += "\\";
+        wide += char(b);
+        wide += string(b + 1, 'a');
+    }
+    DFA wideDfa = minimizeDFA(compileRegex(wide + ")#", times));
+    CompactMatcher wideMatcher;
+    if (!compileMatcher(wideDfa, wideMatcher)) return;
+    int disagreements = 0;
+    for (int b = 0; b < 256; ++b) {
+        for (int extra : {0, 1, 2}) {
+            string input = string(1, char(b)) + string(b + extra, 'a');
+            MatchResult x = longestMatch(wideDfa, input), y = longestMatch(wideMatcher, input);
+            bool full = x.matched && x.length == input.size();
+            if (x.matched != y.matched || x.length != y.length || full != (extra == 1)) ++disagreements;
+        }
+    }
+    cout << "\nAll-bytes alternation: " << wideMatcher.classCount << " classes, "
+         << (disagreements ? "matchers disagree" : "matchers agree") << "\n";
+    if (disagreements) cerr << "Warning: matchers disagree on " << disagreements << " all-bytes inputs\n";
+}
+
+// Matches the same inputs with eager and lazy DFAs. (a|b)*a(a|b)^n needs
+// 2^(n+1) DFA states, so past n = 12 only the lazy engine is run, with its
+// cache held to budgetKB; the word alternation shows the cost of laziness
+// on an automaton whose working set fits. Lazy MB/s includes building
+// the states; the warm pass runs the inputs again over the filled cache.
+void runLazyBenchmark(size_t budgetKB) {
+    using Clock = chrono::steady_clock;
+    mt19937 rng(11);
+    struct Case {
+        string name, regex;
+        vector<string> inputs;
+    };
+    vector<Case> cases;
+    for (int n : {8, 12, 16, 20}) {
+        Case c{"(a|b)*a(a|b)^" + to_string(n), "(a|b)*a", {}};
+        for (int i = 0; i < n; ++i) c.regex += "(a|b)";
+        for (int i = 0; i < 32; ++i) {
+            string text(65536, 'a');
+            for (char& ch : text) ch = "ab"[rng() % 2];
+            c.inputs.push_back(text);
+        }
+        cases.push_back(c);
+    }
+    Case words{"5000 words", "(", {}};
+    for (int w = 0; w < 5000; ++w) {
+        string word;
+        for (int len = 3 + rng() % 8; len > 0; --len) word += char('a' + rng() % 26);
+        words.regex += (w ? "|" : "") + word;
+        words.inputs.push_back(word);
+    }
+    words.regex += ")";
+    for (int i = 0; i < 200000; ++i) words.inputs.push_back(words.inputs[rng() % 5000]);
+    cases.push_back(words);
+
+    auto time = [&](auto&& match, const vector<string>& inputs, size_t& matched) {
+        auto start = Clock::now();
+        matched = 0;
+        size_t bytes = 0;
+        for (const string& s : inputs) {
+            matched += match(s).length;
+            bytes += s.size();
+        }
+        return bytes / 1e6 / chrono::duration<double>(Clock::now() - start).count();
+    };
+
+    cout << "Lazy cache budget " << budgetKB << " KB\n\n";
+    cout << left << setw(20) << "Regex" << setw(10) << "States" << setw(12) << "Build ms" << setw(12) << "Eager MB/s"
+         << setw(10) << "Built" << setw(10) << "Cached" << setw(10) << "Flushes" << setw(12) << "Cache KB"
+         << setw(12) << "Lazy MB/s" << "Warm MB/s\n";
+    cout << string(127, '-') << "\n";
+    for (Case& c : cases) {
+        string eagerStates = "-", buildMs = "-", eagerSpeed = "-";
+        size_t eagerMatched = 0, lazyMatched = 0;
+        if (c.name.find("^16") == string::npos && c.name.find("^20") == string::npos) {
+            BuildTimes times;
+            DFA dfa = compileRegex(c.regex + "#", times);
+            ostringstream ms, speed;
+            ms << fixed << setprecision(2) << times.followposMs + times.dfaMs;
+            speed << fixed << setprecision(0)
+                  << time([&](const string& s) { return longestMatch(dfa, s); }, c.inputs, eagerMatched);
+            eagerStates = to_string(dfa.stateCount());
+            buildMs = ms.str();
+            eagerSpeed = speed.str();
+        }
+        int root = buildFollowpos(toPostfix(c.regex + "#"), {0});
+        LazyDFA lazy(root, budgetKB * 1024);
+        double lazySpeed = time([&](const string& s) { return lazy.longestMatch(s); }, c.inputs, lazyMatched);
+        size_t warmMatched;
+        double warmSpeed = time([&](const string& s) { return lazy.longestMatch(s); }, c.inputs, warmMatched);
+        cout << left << setw(20) << c.name << setw(10) << eagerStates << setw(12) << buildMs << setw(12) << eagerSpeed
+             << setw(10) << lazy.statesBuilt() << setw(10) << lazy.stateCount() << setw(10) << lazy.flushCount()
+             << setw(12) << lazy.memoryUsage() / 1024 << fixed << setprecision(0) << setw(12) << lazySpeed
+             << warmSpeed << "\n";
+        if ((eagerSpeed != "-" && eagerMatched != lazyMatched) || warmMatched != lazyMatched) cerr << "Warning: eager and lazy matches differ\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--bench") {
+        runBenchmark();
+        return 0;
+    }
+    if (argc > 2 && string(argv[1]) == "--spec")
+        return runTokenSpec(argv[2], argc > 3 ? argv[3] : "");
+    if (argc > 1 && string(argv[1]) == "--lazy-bench") {
+        runLazyBenchmark(argc > 2 ? stoul(argv[2]) : 16384);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--match-bench") {
+        runMatchBenchmark(argc > 2 ? argv[2] : "");
+        return 0;
+    }
+
     string input;
     cout << "Enter Regular Expression (with #): ";
     cin >> input;
+    if (countSubtrees(toPostfix(input)) != 1) {
+        cerr << "Malformed regular expression: " << input << "\n";
+        return 1;
+    }
 
-    string postfix = toPostfix(input);
-    Node* root = buildSyntaxTree(postfix);
-    computeNullableFirstLast(root);
-    computeFollowpos(root);
+    BuildTimes times;
+    int rootIndex;
+    DFA dfa = compileRegex(input, times, &rootIndex);
+    const Node* root = &syntaxTree[rootIndex];
 
     printNodeTable(positionNodes);
 
@@ -242,6 +1428,29 @@ int main() {
 
     printFollowposTable(followposMap);
 
+    cout << "\nDFA: " << dfa.stateCount() << " states over " << dfa.alphabet.size() << " symbols, built in "
+         << fixed << setprecision(3) << times.dfaMs << " ms (followpos " << times.followposMs << " ms)\n";
+    if (dfa.stateCount() <= 64)
+        printDFATable(dfa);
+
+    auto minStart = chrono::steady_clock::now();
+    DFA min = minimizeDFA(dfa);
+    double minMs = chrono::duration<double, milli>(chrono::steady_clock::now() - minStart).count();
+    cout << "\nMinimized DFA: " << dfa.stateCount() << " -> " << min.stateCount() << " states in "
+         << fixed << setprecision(3) << minMs << " ms\n";
+    if (min.stateCount() < dfa.stateCount() && min.stateCount() <= 64)
+        printDFATable(min);
+
+    cout << "\nEnter strings to match (end of input to finish):\n";
+    string text;
+    while (cin >> text) {
+        MatchResult m = longestMatch(min, text);
+        cout << text << " : ";
+        if (!m.matched) cout << "no match\n";
+        else if (m.length == text.size()) cout << "match\n";
+        else cout << "prefix match, length " << m.length << "\n";
+    }
+
     return 0;
 }
 
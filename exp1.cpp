@@ -1,40 +1,26 @@
 #include <iostream>
-#include <fstream>
 #include <sstream>
-#include <regex>
 #include <vector>
 #include <set>
+#include <string_view>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include "char_scan.h"
+#include "comment_scan.h"
+#include "keywords.h"
+#include "mapped_file.h"
+#include "numeric_literal.h"
+#include "parallel_lex.h"
+#include "source_files.h"
+#include "utf8.h"
 
 using namespace std;
 
-vector<string> keywords = {
-    "int", "float", "char", "if", "else", "while", "for", "return", "void", "double", "string"
-};
-
-set<string> operators = { "+", "-", "*", "/", "=", "==", "!=", "<", ">", "<=", ">=" };
+set<string, less<>> operators = { "+", "-", "*", "/", "=", "==", "!=", "<", ">", "<=", ">=" };
 set<char> specialSymbols = { '(', ')', '{', '}', ';', ',' };
 
-bool isKeyword(const string& token) {
-    return find(keywords.begin(), keywords.end(), token) != keywords.end();
-}
-
-bool isValidIdentifier(const string& token) {
-    if (token.empty()) return false;
-    if (!isalpha(token[0]) && token[0] != '_') return false;
-    for (size_t i = 1; i < token.length(); ++i)
-        if (!isalnum(token[i]) && token[i] != '_') return false;
-    return true;
-}
-
-bool isInteger(const string& token) {
-    return regex_match(token, regex("^[0-9]+$"));
-}
-
-bool isFloat(const string& token) {
-    return regex_match(token, regex("^[0-9]*\\.[0-9]+$"));
-}
-
-bool isOperator(const string& token) {
+bool isOperator(string_view token) {
     return operators.find(token) != operators.end();
 }
 
@@ -42,109 +28,265 @@ bool isSpecialSymbol(char c) {
     return specialSymbols.find(c) != specialSymbols.end();
 }
 
-int main() {
-    ifstream file("test_input.cpp");
-    if (!file.is_open()) {
-        cerr << "Error opening input file.\n";
-        return 1;
-    }
+struct TokenCounts {
+    long long keywordCount = 0, identifierCount = 0, intCount = 0, floatCount = 0;
+    long long operatorCount = 0, symbolCount = 0, errorCount = 0;
 
-    string line;
-    bool inMultilineComment = false;
-    int keywordCount = 0, identifierCount = 0, intCount = 0, floatCount = 0;
-    int operatorCount = 0, symbolCount = 0, errorCount = 0;
+    long long total() const {
+        return keywordCount + identifierCount + intCount + floatCount + operatorCount + symbolCount;
+    }
+};
 
-    while (getline(file, line)) {
+// Lexes source and adds its tokens to counts. Lexical errors are reported
+// to errors unless it is null. Returns whether source ends inside a comment.
+bool countTokens(string_view source, TokenCounts& counts, ostream* errors, bool inMultilineComment = false) {
+    // Code segments and tokens are views into source; nothing is copied.
+    return forEachCodeSpan(source, [&](int, string_view line) {
         size_t i = 0;
-
-        // Handle multiline comments
-        if (inMultilineComment) {
-            if (line.find("*/") != string::npos)
-                inMultilineComment = false;
-            continue;
-        }
-        if (line.find("/*") != string::npos) {
-            inMultilineComment = true;
-            continue;
-        }
-
-        // Remove single-line comments
-        size_t commentPos = line.find("//");
-        if (commentPos != string::npos)
-            line = line.substr(0, commentPos);
-
-        string token = "";
+        string_view token;
         while (i < line.length()) {
             char c = line[i];
 
-            if (isspace(c)) {
-                ++i;
+            if (isspace((unsigned char)c)) {
+                i = skipSpace(line, i);
                 continue;
             }
 
             if (isSpecialSymbol(c)) {
-                ++symbolCount;
+                ++counts.symbolCount;
                 ++i;
                 continue;
             }
 
-            if (ispunct(c) && !isSpecialSymbol(c)) {
+            if (ispunct((unsigned char)c) && !isSpecialSymbol(c)) {
                 // Handle multi-character operators
                 if (i + 1 < line.length()) {
-                    string op = string(1, c) + line[i + 1];
+                    string_view op = line.substr(i, 2);
                     if (isOperator(op)) {
-                        ++operatorCount;
+                        ++counts.operatorCount;
                         i += 2;
                         continue;
                     }
                 }
 
-                string op(1, c);
+                string_view op = line.substr(i, 1);
                 if (isOperator(op)) {
-                    ++operatorCount;
+                    ++counts.operatorCount;
                     ++i;
                     continue;
                 }
             }
 
-            // Build a token
-            token = "";
-            while (i < line.length() && (isalnum(line[i]) || line[i] == '_' || line[i] == '.')) {
-                token += line[i++];
+            // Numbers; anything still attached to one makes the token invalid
+            if (startsNumber(line, i)) {
+                size_t start = i;
+                NumericLiteral num = scanNumber(line, i);
+                i = skipWord(line, num.end);
+                if (i == num.end && num.kind == NUM_INTEGER)
+                    ++counts.intCount;
+                else if (i == num.end && num.kind == NUM_FLOAT)
+                    ++counts.floatCount;
+                else {
+                    if (errors) *errors << "Lexical Error: Unrecognized token '" << line.substr(start, i - start) << "'\n";
+                    ++counts.errorCount;
+                }
+                continue;
             }
 
+            // Build a token
+            size_t start = i;
+            i = skipUnicodeWord(line, i);
+            token = line.substr(start, i - start);
+
             if (token.empty()) {
+                // Non-ASCII characters that cannot be part of an identifier
+                if ((unsigned char)c >= 0x80) {
+                    i += charLength(line, i);
+                    if (errors) *errors << "Lexical Error: Unrecognized token '" << line.substr(start, i - start) << "'\n";
+                    ++counts.errorCount;
+                    continue;
+                }
                 ++i;
                 continue;
             }
 
             if (isKeyword(token))
-                ++keywordCount;
-            else if (isInteger(token))
-                ++intCount;
-            else if (isFloat(token))
-                ++floatCount;
-            else if (isValidIdentifier(token))
-                ++identifierCount;
+                ++counts.keywordCount;
+            else if (isIdentifier(token))
+                ++counts.identifierCount;
             else {
-                cerr << "Lexical Error: Unrecognized token '" << token << "'\n";
-                ++errorCount;
+                if (errors) *errors << "Lexical Error: Unrecognized token '" << token << "'\n";
+                ++counts.errorCount;
             }
         }
-    }
+    }, 1, inMultilineComment);
+}
 
-    int totalTokens = keywordCount + identifierCount + intCount + floatCount + operatorCount + symbolCount;
+TokenCounts& operator+=(TokenCounts& a, const TokenCounts& b) {
+    a.keywordCount += b.keywordCount;
+    a.identifierCount += b.identifierCount;
+    a.intCount += b.intCount;
+    a.floatCount += b.floatCount;
+    a.operatorCount += b.operatorCount;
+    a.symbolCount += b.symbolCount;
+    a.errorCount += b.errorCount;
+    return a;
+}
+
+// Lexes source on `threads` threads. Counts and errors match a serial run.
+void countTokensParallel(string_view source, int threads, TokenCounts& counts, ostream* errors) {
+    struct ChunkResult {
+        TokenCounts counts;
+        ostringstream errors;
+    };
+    auto results = lexInParallel<ChunkResult>(source, threads,
+        [&](const SourceChunk& chunk, bool inComment, ChunkResult& r) {
+            return countTokens(chunk.text, r.counts, errors ? &r.errors : nullptr, inComment);
+        });
+    for (auto& r : results) {
+        counts += r.counts;
+        if (errors) *errors << r.errors.str();
+    }
+}
 
+void printCounts(const TokenCounts& counts) {
     cout << "Token Counts:\n";
-    cout << "Keywords       : " << keywordCount << "\n";
-    cout << "Identifiers    : " << identifierCount << "\n";
-    cout << "Integers       : " << intCount << "\n";
-    cout << "Floats         : " << floatCount << "\n";
-    cout << "Operators      : " << operatorCount << "\n";
-    cout << "Special Symbols: " << symbolCount << "\n";
-    cout << "Errors         : " << errorCount << "\n";
+    cout << "Keywords       : " << counts.keywordCount << "\n";
+    cout << "Identifiers    : " << counts.identifierCount << "\n";
+    cout << "Integers       : " << counts.intCount << "\n";
+    cout << "Floats         : " << counts.floatCount << "\n";
+    cout << "Operators      : " << counts.operatorCount << "\n";
+    cout << "Special Symbols: " << counts.symbolCount << "\n";
+    cout << "Errors         : " << counts.errorCount << "\n";
     cout << "-----------------------------\n";
-    cout << "Total Tokens   : " << totalTokens << "\n";
+    cout << "Total Tokens   : " << counts.total() << "\n";
+}
+
+// Lexes source with the scalar and each available SIMD run scanner and
+// reports throughput; all modes must agree on the counts. With more than one
+// thread, the parallel lexer is measured against the serial one as well.
+void runBenchmark(string_view source, int threads) {
+    using Clock = chrono::steady_clock;
+    vector<ScanMode> modes = {SCAN_SCALAR};
+#ifdef CHAR_SCAN_X86
+    modes.push_back(SCAN_SSE2);
+    if (char_scan::bestMode() == SCAN_AVX2) modes.push_back(SCAN_AVX2);
+#endif
+
+    long long expected = -1;
+    auto measure = [&](const string& name, double baseRate, auto&& lexAll) {
+        TokenCounts counts;
+        int rounds = 0;
+        double elapsed = 0;
+        auto start = Clock::now();
+        do {
+            counts = TokenCounts();
+            lexAll(counts);
+            ++rounds;
+            elapsed = chrono::duration<double>(Clock::now() - start).count();
+        } while (elapsed < 0.5);
+
+        double rate = source.size() * (double)rounds / elapsed / 1e6;
+        cout << left << setw(12) << name << fixed << setprecision(1) << rate << " MB/s, "
+             << setprecision(0) << counts.total() * (double)rounds / elapsed << " tokens/sec ("
+             << setprecision(2) << rate / (baseRate ? baseRate : rate) << "x)\n";
+
+        if (expected >= 0 && counts.total() != expected)
+            cerr << "Warning: " << name << " disagrees with the scalar scanner\n";
+        expected = counts.total();
+        return rate;
+    };
+
+    double scalarRate = 0, serialRate = 0;
+    for (ScanMode mode : modes) {
+        scanMode = mode;
+        serialRate = measure(scanModeName(mode), scalarRate, [&](TokenCounts& counts) {
+            countTokens(source, counts, nullptr);
+        });
+        if (mode == SCAN_SCALAR) scalarRate = serialRate;
+    }
+
+    if (threads > 1)
+        measure(to_string(threads) + " threads", serialRate, [&](TokenCounts& counts) {
+            countTokensParallel(source, threads, counts, nullptr);
+        });
+}
+
+// Lexes every file on a pool of `threads` workers, then prints the counts
+// of each file in sorted path order followed by the totals. Returns the
+// number of files that could not be opened.
+int runBatch(const vector<string>& paths, int threads) {
+    struct FileResult {
+        bool opened = false;
+        TokenCounts counts;
+        ostringstream errors;
+    };
+    vector<string> files = collectSourceFiles(paths);
+    vector<FileResult> results(files.size());
+
+    runOnWorkers(files.size(), threads, [&](size_t i) {
+        MappedFile file(files[i]);
+        results[i].opened = file.is_open();
+        if (!results[i].opened) return;
+        reportInvalidUtf8(file.view(), results[i].errors);
+        countTokens(file.view(), results[i].counts, &results[i].errors);
+    });
+
+    TokenCounts total;
+    int failed = 0;
+    for (size_t i = 0; i < files.size(); ++i) {
+        cout << "File: " << files[i] << "\n";
+        if (!results[i].opened) {
+            cerr << files[i] << ": Error opening input file.\n";
+            ++failed;
+            cout << "\n";
+            continue;
+        }
+        istringstream errors(results[i].errors.str());
+        for (string line; getline(errors, line);) cerr << files[i] << ": " << line << "\n";
+        printCounts(results[i].counts);
+        cout << "\n";
+        total += results[i].counts;
+    }
+
+    cout << "Total (" << files.size() - failed << " files)\n";
+    printCounts(total);
+    return failed;
+}
+
+int main(int argc, char* argv[]) {
+    bool bench = false, batch = false;
+    int threads = 1;
+    vector<string> paths;
+    for (int a = 1; a < argc; ++a) {
+        string arg = argv[a];
+        if (arg == "--bench") bench = true;
+        else if (arg == "--batch") batch = true;
+        else if (arg == "--threads" && a + 1 < argc) threads = max(1, atoi(argv[++a]));
+        else paths.push_back(arg);
+    }
+
+    if (batch)
+        return runBatch(paths, threads) == 0 ? 0 : 1;
+
+    MappedFile file(paths.empty() ? "test_input.cpp" : paths.back());
+    if (!file.is_open()) {
+        cerr << "Error opening input file.\n";
+        return 1;
+    }
+
+    if (bench) {
+        runBenchmark(file.view(), threads);
+        return 0;
+    }
+
+    reportInvalidUtf8(file.view(), cerr);
+    TokenCounts counts;
+    if (threads > 1)
+        countTokensParallel(file.view(), threads, counts, &cerr);
+    else
+        countTokens(file.view(), counts, &cerr);
+    printCounts(counts);
 
     return 0;
 }
@@ -1,139 +1,378 @@
 #include <iostream>
-#include <fstream>
 #include <sstream>
-#include <regex>
 #include <vector>
 #include <set>
-#include <iomanip>
+#include <string_view>
+#include <optional>
+#include <memory>
+#include <unordered_map>
+#include "char_scan.h"
+#include "comment_scan.h"
+#include "include_scan.h"
+#include "keywords.h"
+#include "mapped_file.h"
+#include "numeric_literal.h"
+#include "report_writer.h"
+#include "token_cache.h"
+#include "utf8.h"
 
 using namespace std;
 
-vector<string> keywords = {
-    "int", "float", "char", "double", "void", "if", "else", "while", "for", "return", "string", "bool"
-};
-
-set<string> operators = { "+", "-", "*", "/", "=", "==", "!=", "<", ">", "<=", ">=" };
+set<string, less<>> operators = { "+", "-", "*", "/", "=", "==", "!=", "<", ">", "<=", ">=" };
 set<char> specialSymbols = { '(', ')', '{', '}', ';', ',' };
 
-bool isKeyword(const string& token) {
-    return find(keywords.begin(), keywords.end(), token) != keywords.end();
+bool isOperator(string_view token) {
+    return operators.find(token) != operators.end();
 }
 
-bool isValidIdentifier(const string& token) {
-    if (token.empty()) return false;
-    if (!isalpha(token[0]) && token[0] != '_') return false;
-    for (size_t i = 1; i < token.length(); ++i)
-        if (!isalnum(token[i]) && token[i] != '_') return false;
-    return true;
+bool isSpecialSymbol(char c) {
+    return specialSymbols.find(c) != specialSymbols.end();
 }
 
-bool isInteger(const string& token) {
-    return regex_match(token, regex("^[0-9]+$"));
-}
+const char* kindName[] = {"Special Symbol", "Operator", "Keyword", "Integer", "Float", "Identifier", "Literal"};
 
-bool isFloat(const string& token) {
-    return regex_match(token, regex("^[0-9]*\\.[0-9]+$"));
-}
+// With --count, tokens are only counted and a total is printed at the end.
+bool countOnly = false;
+long long tokenCount = 0;
 
-bool isOperator(const string& token) {
-    return operators.find(token) != operators.end();
-}
+// Token report, padded text by default or CSV / JSON Lines with --format.
+ReportWriter out;
+ReportFormat format = REPORT_TEXT;
 
-bool isSpecialSymbol(char c) {
-    return specialSymbols.find(c) != specialSymbols.end();
+// With --cache-dir, every token is also recorded for the token cache.
+optional<TokenCacheWriter> cacheWriter;
+
+// Errors name the file only in include mode, where tokens come from several.
+void printToken(CachedKind kind, string_view value, int lineNo, string_view file = {}) {
+    if (kind == CK_ERROR) {
+        cerr << "Lexical Error (";
+        if (!file.empty()) cerr << file << ", ";
+        cerr << "Line " << lineNo << "): Invalid token '" << value << "'\n";
+        return;
+    }
+    ++tokenCount;
+    if (countOnly) return;
+    if (format == REPORT_CSV)
+        out.text(kindName[kind]).put(',').csvField(value).put(',').number(lineNo).put('\n');
+    else if (format == REPORT_JSONL)
+        out.text("{\"type\":").jsonString(kindName[kind]).text(",\"lexeme\":").jsonString(value)
+           .text(",\"line\":").number(lineNo).text("}\n");
+    else
+        out.padded(kindName[kind], 18).text(": ").text(value).put('\n');
 }
 
-void printToken(const string& type, const string& value) {
-    cout << left << setw(18) << type << ": " << value << "\n";
+void emitToken(CachedKind kind, string_view value, int lineNo) {
+    if (cacheWriter) cacheWriter->add(kind, value, lineNo);
+    printToken(kind, value, lineNo);
 }
 
-int main() {
-    ifstream file("test_input.cpp");
-    if (!file.is_open()) {
-        cerr << "Error: Could not open input file.\n";
-        return 1;
+// Prints the tokens of a cache hit exactly as lexing the source would.
+void replayTokens(const TokenCache& cache) {
+    int lineNo = 1;
+    for (const CachedToken& token : cache) {
+        lineNo += token.lineDelta();
+        printToken(token.kind(), cache.lexeme(token.symbol), lineNo);
     }
+}
+
+// Lexes one code segment of line lineNo, calling emit(kind, lexeme, lineNo)
+// for every token. Lexemes are views into line.
+template <typename Emit>
+void lexSegment(string_view line, int lineNo, Emit&& emit) {
+    size_t i = 0;
+
+    while (i < line.length()) {
+        if (isspace((unsigned char)line[i])) {
+            i = skipSpace(line, i);
+            continue;
+        }
 
-    string line;
-    bool inMultilineComment = false;
-    int lineNo = 0;
+        // String and character literals, escapes included, as the comment
+        // scanner sees them; one left open runs to the end of the segment
+        if (line[i] == '"' || line[i] == '\'') {
+            size_t close = skipQuoted(line, i);
+            if (close == string_view::npos) {
+                emit(CK_ERROR, line.substr(i), lineNo);
+                break;
+            }
+            emit(CK_LITERAL, line.substr(i, close - i), lineNo);
+            i = close;
+            continue;
+        }
 
-    cout << "Detected Tokens:\n----------------\n";
+        if (isSpecialSymbol(line[i])) {
+            emit(CK_SPECIAL_SYMBOL, line.substr(i, 1), lineNo);
+            ++i;
+            continue;
+        }
 
-    while (getline(file, line)) {
-        ++lineNo;
-        size_t i = 0;
+        // Operator handling (1 or 2 characters)
+        string_view op = line.substr(i, 2);
 
-        // Handle multi-line comment
-        if (inMultilineComment) {
-            if (line.find("*/") != string::npos)
-                inMultilineComment = false;
+        if (isOperator(op)) {
+            emit(CK_OPERATOR, op, lineNo);
+            i += 2;
+            continue;
+        } else if (isOperator(line.substr(i, 1))) {
+            emit(CK_OPERATOR, line.substr(i, 1), lineNo);
+            ++i;
             continue;
         }
 
-        if (line.find("/*") != string::npos) {
-            inMultilineComment = true;
+        // Numbers; anything still attached to one makes the token invalid
+        if (isdigit((unsigned char)line[i])) {
+            size_t start = i;
+            NumericLiteral num = scanNumber(line, i);
+            i = skipWord(line, num.end);
+            string_view token = line.substr(start, i - start);
+
+            if (i == num.end && num.kind == NUM_INTEGER)
+                emit(CK_INTEGER, token, lineNo);
+            else if (i == num.end && num.kind == NUM_FLOAT)
+                emit(CK_FLOAT, token, lineNo);
+            else
+                emit(CK_ERROR, token, lineNo);
             continue;
         }
 
-        // Remove single-line comment
-        size_t commentPos = line.find("//");
-        if (commentPos != string::npos)
-            line = line.substr(0, commentPos);
+        // Tokenization (identifiers, keywords), including Unicode identifiers
+        if (identStartLength(line, i)) {
+            size_t start = i;
+            i = skipUnicodeWord(line, i);
+            string_view token = line.substr(start, i - start);
 
-        while (i < line.length()) {
-            if (isspace(line[i])) {
-                ++i;
-                continue;
-            }
+            if (isKeyword(token))
+                emit(CK_KEYWORD, token, lineNo);
+            else if (isIdentifier(token))
+                emit(CK_IDENTIFIER, token, lineNo);
+            else
+                emit(CK_ERROR, token, lineNo);
+        }
+        else {
+            // Invalid character; a whole UTF-8 sequence is reported at once
+            size_t len = charLength(line, i);
+            emit(CK_ERROR, line.substr(i, len), lineNo);
+            i += len;
+        }
+    }
+}
 
-            if (isSpecialSymbol(line[i])) {
-                printToken("Special Symbol", string(1, line[i]));
-                ++i;
-                continue;
-            }
+// ---------------- Include-aware lexing ----------------
+// Each file is lexed once into a token list in which #include lines are
+// CK_INCLUDE markers, and the list is reused by every translation unit that
+// includes the file until its mtime or size changes. With --cache-dir the
+// lists are also kept on disk, keyed by path and stamp, for later runs.
+// Expanding a translation unit replays the lists, following the markers.
 
-            // Operator handling (1 or 2 characters)
-            string op = "";
-            op += line[i];
-            if (i + 1 < line.length())
-                op += line[i + 1];
-
-            if (isOperator(op)) {
-                printToken("Operator", op);
-                i += 2;
-                continue;
-            } else if (isOperator(string(1, line[i]))) {
-                printToken("Operator", string(1, line[i]));
-                ++i;
-                continue;
-            }
+struct FileTokens {
+    struct Token {
+        CachedKind kind;
+        uint32_t symbol;
+        int line;
+    };
+    FileStamp stamp;
+    StringInterner names;
+    vector<Token> tokens;
+    string guard;           // include guard macro, if any
+    bool pragmaOnce = false;
+
+    void add(CachedKind kind, string_view lexeme, int line) {
+        if (kind == CK_GUARD) guard = lexeme;
+        else if (kind == CK_PRAGMA_ONCE) pragmaOnce = true;
+        else tokens.push_back({kind, names.intern(lexeme), line});
+    }
+};
+
+struct IncludeStats {
+    long long lexed = 0, fromDisk = 0, reused = 0, skipped = 0;
+};
 
-            // Tokenization (identifiers, numbers, etc.)
-            string token = "";
-            if (isalpha(line[i]) || line[i] == '_' || isdigit(line[i])) {
-                while (i < line.length() && (isalnum(line[i]) || line[i] == '_' || line[i] == '.')) {
-                    token += line[i++];
-                }
-
-                if (isKeyword(token))
-                    printToken("Keyword", token);
-                else if (isInteger(token))
-                    printToken("Integer", token);
-                else if (isFloat(token))
-                    printToken("Float", token);
-                else if (isValidIdentifier(token))
-                    printToken("Identifier", token);
-                else
-                    cerr << "Lexical Error (Line " << lineNo << "): Invalid token '" << token << "'\n";
+struct TranslationUnit {
+    set<string> included;          // canonical paths expanded so far
+    set<string, less<>> guards;    // guard macros defined so far
+};
+
+vector<string> includePath;        // -I directories, in search order
+unordered_map<string, shared_ptr<const FileTokens>> fileTokens; // by canonical path
+set<string> missingIncludes;       // warned about once each
+IncludeStats includeStats;
+string includeCacheDir;
+
+// Cache entries for include mode are keyed by path and stamp, not contents.
+uint64_t includeCacheKey(const string& path, const FileStamp& stamp) {
+    string key = "include:" + path + '\0' + to_string(stamp.mtimeNanos) + ':' + to_string(stamp.size);
+    return contentHash(key);
+}
+
+// Lexes a file into tokens, recording #include and #pragma once lines and
+// the include guard as markers instead of lexing them.
+template <typename Add>
+void lexWithDirectives(string_view source, Add&& add) {
+    IncludeGuardTracker guard;
+    int lastLine = 0;
+    forEachCodeSpan(source, [&](int lineNo, string_view segment) {
+        Directive d = lineNo != lastLine ? parseDirective(segment) : Directive();
+        lastLine = lineNo;
+        guard.add(d);
+        if (d.kind == DIR_INCLUDE) add(CK_INCLUDE, d.spec, lineNo);
+        else if (d.kind == DIR_PRAGMA_ONCE) add(CK_PRAGMA_ONCE, segment.substr(segment.find("once"), 4), lineNo);
+        else lexSegment(segment, lineNo, add);
+    });
+    if (!guard.guard().empty()) add(CK_GUARD, guard.guard(), max(lastLine, 1));
+}
+
+// Tokens of the file at a canonical path: from memory if its stamp is
+// unchanged, else from the disk cache, else lexed. Null if it cannot be read.
+// Shared so a caller still walking an older version keeps it alive when a
+// nested include reloads the same path.
+shared_ptr<const FileTokens> loadFileTokens(const string& path) {
+    FileStamp stamp;
+    if (!statFile(path, stamp)) return nullptr;
+    auto cached = fileTokens.find(path);
+    if (cached != fileTokens.end() && cached->second->stamp == stamp) {
+        ++includeStats.reused;
+        return cached->second;
+    }
+    auto slot = make_shared<FileTokens>();
+    slot->stamp = stamp;
+
+    uint64_t key = includeCacheKey(path, stamp);
+    if (!includeCacheDir.empty()) {
+        TokenCache cache(tokenCachePath(includeCacheDir, key), key, stamp.size);
+        if (cache.valid()) {
+            int lineNo = 1;
+            for (const CachedToken& token : cache) {
+                lineNo += token.lineDelta();
+                slot->add(token.kind(), cache.lexeme(token.symbol), lineNo);
             }
-            else {
-                // Invalid single character
-                cerr << "Lexical Error (Line " << lineNo << "): Invalid token '" << line[i] << "'\n";
-                ++i;
+            ++includeStats.fromDisk;
+            return fileTokens[path] = slot;
+        }
+    }
+
+    MappedFile file(path);
+    if (!file.is_open()) {
+        fileTokens.erase(path);
+        return nullptr;
+    }
+    optional<TokenCacheWriter> writer;
+    if (!includeCacheDir.empty()) writer.emplace(file.view());
+    lexWithDirectives(file.view(), [&](CachedKind kind, string_view lexeme, int lineNo) {
+        if (writer) writer->add(kind, lexeme, lineNo);
+        slot->add(kind, lexeme, lineNo);
+    });
+    if (writer && !writer->save(tokenCachePath(includeCacheDir, key), key))
+        cerr << "Warning: Could not write token cache to " << includeCacheDir << "\n";
+    ++includeStats.lexed;
+    return fileTokens[path] = slot;
+}
+
+// Prints the tokens of a file into the translation unit, expanding its
+// includes in place. A file is skipped if its guard macro is already
+// defined, or if it has #pragma once and was already expanded.
+void expandFile(const string& path, TranslationUnit& unit, int depth) {
+    if (depth > 200) {
+        cerr << "Error: #include nested too deeply at " << path << "\n";
+        return;
+    }
+    shared_ptr<const FileTokens> ft = loadFileTokens(path);
+    if (!ft) {
+        cerr << "Error: Could not open " << path << "\n";
+        return;
+    }
+    if ((ft->pragmaOnce && unit.included.count(path)) || (!ft->guard.empty() && unit.guards.count(ft->guard))) {
+        ++includeStats.skipped;
+        return;
+    }
+    unit.included.insert(path);
+    if (!ft->guard.empty()) unit.guards.insert(ft->guard);
+
+    for (const FileTokens::Token& token : ft->tokens) {
+        string_view lexeme = ft->names.lexeme(token.symbol);
+        if (token.kind != CK_INCLUDE) {
+            printToken(token.kind, lexeme, token.line, path);
+            continue;
+        }
+        Directive d;
+        d.kind = DIR_INCLUDE;
+        d.spec = lexeme;
+        d.angled = lexeme[0] == '<';
+        d.name = lexeme.substr(1, lexeme.size() - 2);
+        string resolved = resolveInclude(d, path, includePath);
+        if (!resolved.empty())
+            expandFile(resolved, unit, depth + 1);
+        else if (missingIncludes.insert(string(lexeme)).second)
+            cerr << "Warning: Cannot find include " << lexeme << " (from " << path << ")\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    string path = "test_input.cpp", cacheDir;
+    bool followIncludes = false;
+    vector<string> paths;
+    for (int a = 1; a < argc; ++a) {
+        string arg = argv[a];
+        if (arg == "--count") countOnly = true;
+        else if (arg == "--cache-dir" && a + 1 < argc) cacheDir = argv[++a];
+        else if (arg == "--includes") followIncludes = true;
+        else if (arg == "-I" && a + 1 < argc) includePath.push_back(argv[++a]);
+        else if (arg == "--format" && a + 1 < argc) {
+            if (!parseReportFormat(argv[++a], format)) {
+                cerr << "Unknown format " << argv[a] << " (expected text, csv or jsonl)\n";
+                return 1;
             }
         }
+        else paths.push_back(path = arg);
+    }
+
+    if (followIncludes) {
+        if (paths.empty()) paths.push_back(path);
+        includeCacheDir = cacheDir;
+        if (!countOnly && format == REPORT_TEXT) out.text("Detected Tokens:\n----------------\n");
+        if (!countOnly && format == REPORT_CSV) out.text("type,lexeme,line\n");
+        for (const string& unitPath : paths) {
+            if (!countOnly && format == REPORT_TEXT && paths.size() > 1) out.text("File: ").text(unitPath).put('\n');
+            TranslationUnit unit;
+            expandFile(canonicalPath(unitPath), unit, 0);
+        }
+        if (countOnly) out.text("Tokens: ").number(tokenCount).put('\n');
+        out.flush();
+        cerr << "Files lexed: " << includeStats.lexed << ", loaded from cache: " << includeStats.fromDisk
+             << ", reused: " << includeStats.reused << ", skipped by guard or #pragma once: "
+             << includeStats.skipped << "\n";
+        return 0;
+    }
+
+    MappedFile file(path);
+    if (!file.is_open()) {
+        cerr << "Error: Could not open input file.\n";
+        return 1;
+    }
+
+    reportInvalidUtf8(file.view(), cerr);
+
+    if (!countOnly && format == REPORT_TEXT) out.text("Detected Tokens:\n----------------\n");
+    if (!countOnly && format == REPORT_CSV) out.text("type,lexeme,line\n");
+
+    // Unchanged sources are replayed from the token cache instead of lexed.
+    uint64_t hash = 0;
+    if (!cacheDir.empty()) {
+        hash = contentHash(file.view());
+        TokenCache cache(tokenCachePath(cacheDir, hash), hash, file.view().size());
+        if (cache.valid()) {
+            replayTokens(cache);
+            if (countOnly) out.text("Tokens: ").number(tokenCount).put('\n');
+            return 0;
+        }
+        cacheWriter.emplace(file.view());
     }
 
+    // Code segments and tokens are views into the mapped file; nothing is copied.
+    forEachCodeSpan(file.view(), [&](int lineNo, string_view line) { lexSegment(line, lineNo, emitToken); });
+
+    if (cacheWriter && !cacheWriter->save(tokenCachePath(cacheDir, hash), hash))
+        cerr << "Warning: Could not write token cache to " << cacheDir << "\n";
+
+    if (countOnly) out.text("Tokens: ").number(tokenCount).put('\n');
     return 0;
 }
@@ -0,0 +1,149 @@
+#ifndef INCLUDE_SCAN_H
+#define INCLUDE_SCAN_H
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <sys/stat.h>
+#include "char_scan.h"
+
+// The few preprocessor lines include-aware lexing needs: #include, #pragma
+// once, and the #ifndef / #define / #endif shape of an include guard.
+// Nothing is evaluated; conditionals are only counted.
+
+enum DirectiveKind { DIR_NONE, DIR_INCLUDE, DIR_PRAGMA_ONCE, DIR_IFNDEF, DIR_IF, DIR_ENDIF, DIR_DEFINE, DIR_OTHER };
+
+struct Directive {
+    DirectiveKind kind = DIR_NONE;
+    std::string_view name; // macro name, or the header name of an #include
+    std::string_view spec; // #include operand with its delimiters: "a.h" or <a.h>
+    bool angled = false;
+};
+
+namespace include_scan {
+
+inline size_t wordEnd(std::string_view s, size_t i) {
+    while (i < s.size() && (((s[i] | 0x20) >= 'a' && (s[i] | 0x20) <= 'z') || (s[i] >= '0' && s[i] <= '9') || s[i] == '_'))
+        ++i;
+    return i;
+}
+
+} // namespace include_scan
+
+// Classifies a line of code; kind is DIR_NONE unless it starts with '#'.
+inline Directive parseDirective(std::string_view line) {
+    using include_scan::wordEnd;
+    Directive d;
+    size_t i = skipSpace(line, 0);
+    if (i >= line.size() || line[i] != '#') return d;
+    i = skipSpace(line, i + 1);
+    size_t end = wordEnd(line, i);
+    std::string_view word = line.substr(i, end - i);
+    size_t arg = skipSpace(line, end);
+    size_t argEnd = wordEnd(line, arg);
+    std::string_view name = line.substr(arg, argEnd - arg);
+
+    d.kind = DIR_OTHER;
+    if (word == "include" && arg < line.size() && (line[arg] == '"' || line[arg] == '<')) {
+        size_t close = line.find(line[arg] == '"' ? '"' : '>', arg + 1);
+        if (close != std::string_view::npos) {
+            d.kind = DIR_INCLUDE;
+            d.angled = line[arg] == '<';
+            d.spec = line.substr(arg, close - arg + 1);
+            d.name = line.substr(arg + 1, close - arg - 1);
+        }
+    } else if (word == "pragma" && name == "once") {
+        d.kind = DIR_PRAGMA_ONCE;
+    } else if (word == "ifndef") {
+        d.kind = DIR_IFNDEF;
+        d.name = name;
+    } else if (word == "if" || word == "ifdef") {
+        d.kind = DIR_IF;
+    } else if (word == "endif") {
+        d.kind = DIR_ENDIF;
+    } else if (word == "define") {
+        d.kind = DIR_DEFINE;
+        d.name = name;
+    }
+    return d;
+}
+
+// Recognises a file wrapped in an include guard: its first code line is
+// "#ifndef X", the next is "#define X", and the #endif closing the #ifndef
+// is the last code in the file.
+class IncludeGuardTracker {
+public:
+    // Called for every piece of code in order; d is DIR_NONE for code that
+    // is not a directive (including later segments of a line).
+    void add(const Directive& d) {
+        if (broken) return;
+        if (lines == 0) {
+            broken = d.kind != DIR_IFNDEF || d.name.empty();
+            candidate = d.name;
+            depth = 1;
+        } else if (lines == 1) {
+            broken = d.kind != DIR_DEFINE || d.name != candidate;
+        } else if (depth == 0) {
+            broken = true;
+        } else if (d.kind == DIR_IFNDEF || d.kind == DIR_IF) {
+            ++depth;
+        } else if (d.kind == DIR_ENDIF) {
+            --depth;
+        }
+        ++lines;
+    }
+
+    // The guard macro, or empty if the file does not have the guard shape.
+    std::string_view guard() const { return !broken && lines >= 2 && depth == 0 ? candidate : std::string_view(); }
+
+private:
+    std::string_view candidate;
+    int lines = 0;
+    int depth = 0;
+    bool broken = false;
+};
+
+// What identifies one version of a file: it is re-lexed when either changes.
+struct FileStamp {
+    int64_t mtimeNanos = 0;
+    uint64_t size = 0;
+
+    bool operator==(const FileStamp& o) const { return mtimeNanos == o.mtimeNanos && size == o.size; }
+};
+
+inline bool statFile(const std::string& path, FileStamp& stamp) {
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) return false;
+    stamp.mtimeNanos = (int64_t)st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+    stamp.size = st.st_size;
+    return true;
+}
+
+// Absolute, normalised form of path, so one file has one cache key.
+inline std::string canonicalPath(const std::string& path) {
+    std::error_code ec;
+    std::filesystem::path p = std::filesystem::absolute(path, ec);
+    return (ec ? std::filesystem::path(path) : p).lexically_normal().string();
+}
+
+// Finds an included file: the quoted form looks next to the including file
+// first, then both forms try each search directory in order. Returns the
+// canonical path, or an empty string if no regular file matches.
+inline std::string resolveInclude(const Directive& d, const std::string& includingFile,
+                                  const std::vector<std::string>& searchPath) {
+    std::string name(d.name);
+    FileStamp stamp;
+    if (!d.angled) {
+        std::string local = (std::filesystem::path(includingFile).parent_path() / name).string();
+        if (statFile(local, stamp)) return canonicalPath(local);
+    }
+    for (const std::string& dir : searchPath) {
+        std::string candidate = (std::filesystem::path(dir) / name).string();
+        if (statFile(candidate, stamp)) return canonicalPath(candidate);
+    }
+    return std::string();
+}
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef KEYWORDS_H
+#define KEYWORDS_H
+
+#include <string_view>
+
+// Keyword set shared by every lexer.
+enum Keyword {
+    KW_NONE,
+    KW_INT, KW_FLOAT, KW_CHAR, KW_DOUBLE, KW_VOID, KW_BOOL, KW_STRING,
+    KW_IF, KW_ELSE, KW_WHILE, KW_FOR, KW_RETURN,
+    KW_COUNT
+};
+
+constexpr std::string_view keywordSpelling[KW_COUNT] = {
+    "",
+    "int", "float", "char", "double", "void", "bool", "string",
+    "if", "else", "while", "for", "return"
+};
+
+// Perfect hash over the keyword set: a seed is searched for at compile time
+// so that every keyword lands in its own slot, and a lookup is one hash plus
+// one comparison against the only candidate.
+namespace keyword_hash {
+
+constexpr unsigned TABLE_SIZE = 32;
+
+constexpr unsigned hash(std::string_view s, unsigned seed) {
+    unsigned h = seed ^ (unsigned)s.size();
+    h = h * 31 + (unsigned char)s[0];
+    h = h * 31 + (unsigned char)s[s.size() - 1];
+    h ^= h >> 5;
+    return h & (TABLE_SIZE - 1);
+}
+
+constexpr bool isPerfect(unsigned seed) {
+    bool used[TABLE_SIZE] = {};
+    for (int k = 1; k < KW_COUNT; ++k) {
+        unsigned h = hash(keywordSpelling[k], seed);
+        if (used[h]) return false;
+        used[h] = true;
+    }
+    return true;
+}
+
+constexpr unsigned findSeed() {
+    for (unsigned seed = 0; seed < 100000; ++seed)
+        if (isPerfect(seed)) return seed;
+    return ~0u;
+}
+
+constexpr unsigned SEED = findSeed();
+static_assert(SEED != ~0u, "no perfect hash seed for the keyword set");
+
+struct Table {
+    unsigned char slot[TABLE_SIZE] = {};
+};
+
+constexpr Table buildTable() {
+    Table t;
+    for (int k = 1; k < KW_COUNT; ++k) t.slot[hash(keywordSpelling[k], SEED)] = k;
+    return t;
+}
+
+constexpr Table table = buildTable();
+
+} // namespace keyword_hash
+
+constexpr Keyword lookupKeyword(std::string_view s) {
+    if (s.size() < 2 || s.size() > 6) return KW_NONE;
+    Keyword k = (Keyword)keyword_hash::table.slot[keyword_hash::hash(s, keyword_hash::SEED)];
+    return keywordSpelling[k] == s ? k : KW_NONE;
+}
+
+constexpr bool isKeyword(std::string_view s) {
+    return lookupKeyword(s) != KW_NONE;
+}
+
+static_assert(lookupKeyword("while") == KW_WHILE && lookupKeyword("whale") == KW_NONE,
+              "keyword hash is broken");
+
+#endif
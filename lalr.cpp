@@ -1,4 +1,6 @@
 #include <bits/stdc++.h>
+#include <sys/resource.h>
+#include "mapped_file.h"
 using namespace std;
 
 struct Item {
@@ -43,16 +45,117 @@ string serializeItemSet(const set<Item> &S) {
     return s;
 }
 
+// Source of terminal IDs for LALRParser::parse, produced one at a time.
+class TokenStream {
+public:
+    virtual ~TokenStream() = default;
+    // next terminal ID; the end marker "$" once the input is exhausted
+    virtual int next() = 0;
+};
+
+// Lexes a buffer on demand for a grammar's terminals: whitespace is skipped
+// and the longest terminal spelling at the current position is returned. A
+// character that starts no terminal comes back as an ID past the end marker,
+// which the parser reports as a syntax error.
+class GrammarLexer : public TokenStream {
+public:
+    // terminals: terminal ID -> spelling, with the end marker "$" last
+    GrammarLexer(string_view source, const vector<string> &terminals) : src(source) {
+        endMarker = (int)terminals.size() - 1;
+        for (int id = 0; id < endMarker; ++id) {
+            if (terminals[id].empty()) continue;
+            byFirstChar[(unsigned char)terminals[id][0]].push_back({terminals[id], id});
+        }
+        for (auto &candidates : byFirstChar)
+            sort(candidates.begin(), candidates.end(), [](const auto &a, const auto &b) {
+                return a.first.size() > b.first.size();
+            });
+    }
+
+    int next() override {
+        while (pos < src.size() && isspace((unsigned char)src[pos])) ++pos;
+        tokenStart = pos;
+        if (pos == src.size()) return endMarker;
+        for (auto &cand : byFirstChar[(unsigned char)src[pos]]) {
+            if (src.compare(pos, cand.first.size(), cand.first) == 0) {
+                pos += cand.first.size();
+                return cand.second;
+            }
+        }
+        ++pos;
+        return endMarker + 1;
+    }
+
+    // Input from the start of the last token returned
+    string_view remaining() const { return src.substr(tokenStart); }
+
+    size_t offset() const { return pos; }
+
+    void rewind() { pos = tokenStart = 0; }
+
+private:
+    string_view src;
+    size_t pos = 0, tokenStart = 0;
+    int endMarker;
+    vector<pair<string,int>> byFirstChar[256];
+};
+
+// Lexes unit count times over, so the parser can be fed an input far larger
+// than anything held in memory. Used by --memory-check.
+class RepeatedInput : public TokenStream {
+public:
+    RepeatedInput(string_view unit, const vector<string> &terminals, long long count)
+        : lexer(unit, terminals), endMarker((int)terminals.size() - 1), left(count) {}
+
+    int next() override {
+        int id = lexer.next();
+        while (id == endMarker && --left > 0) {
+            lexer.rewind();
+            id = lexer.next();
+        }
+        return id;
+    }
+
+private:
+    GrammarLexer lexer;
+    int endMarker;
+    long long left;
+};
+
+// Lexes a mapped file for lalr <file>, releasing the pages already read
+// every few megabytes so one pass over a large file keeps peak RSS flat.
+class SinglePassInput : public TokenStream {
+public:
+    SinglePassInput(const MappedFile &file, const vector<string> &terminals)
+        : file(file), lexer(file.view(), terminals) {}
+
+    int next() override {
+        if (lexer.offset() - released >= RELEASE_STEP) {
+            released = lexer.offset();
+            file.releaseBefore(released);
+        }
+        return lexer.next();
+    }
+
+    size_t offset() const { return lexer.offset(); }
+
+private:
+    static constexpr size_t RELEASE_STEP = 4 << 20;
+    const MappedFile &file;
+    GrammarLexer lexer;
+    size_t released = 0;
+};
+
 string serializeCore(const set<Item> &S) {
-    // core = head, body, dot (no lookahead)
-    vector<string> parts;
+    // core = head, body, dot (no lookahead); items differing only in
+    // lookahead collapse to one entry
+    set<string> parts;
     for (const auto &it : S) {
         string p = it.head + "->";
         for (auto &sym : it.body) p += sym + " ";
         p += "|" + to_string(it.dot);
-        parts.push_back(p);
+        parts.insert(p);
     }
-    sort(parts.begin(), parts.end());
     string out;
     for (auto &p : parts) { out += p + ";;"; }
     return out;
@@ -272,23 +375,20 @@ public:
     }
 
     void buildLALRStates() {
-        // group LR(1) states by core
-        map<string, vector<int>> core_map; // serialized core -> list of lr1 indices
-        for (size_t i=0;i<lr1_items_collection.size();++i) {
-            string core_key = serializeCore(lr1_items_collection[i]);
-            core_map[core_key].push_back((int)i);
-        }
-
+        // group LR(1) states by core; LALR states are numbered in order of
+        // their first LR(1) state, so the initial state stays 0
+        map<string, int> core_map; // serialized core -> lalr index
         map<int,int> lr1_to_lalr;
         lalr_states.clear();
-        for (auto &kv : core_map) {
-            set<Item> merged;
-            for (int lr1_idx : kv.second) {
-                for (auto &it : lr1_items_collection[lr1_idx]) merged.insert(it);
+        for (size_t i=0;i<lr1_items_collection.size();++i) {
+            string core_key = serializeCore(lr1_items_collection[i]);
+            auto found = core_map.find(core_key);
+            if (found == core_map.end()) {
+                found = core_map.insert({core_key, (int)lalr_states.size()}).first;
+                lalr_states.push_back({});
             }
-            int newIdx = (int)lalr_states.size();
-            lalr_states.push_back(merged);
-            for (int lr1_idx : kv.second) lr1_to_lalr[lr1_idx] = newIdx;
+            lalr_states[found->second].insert(lr1_items_collection[i].begin(), lr1_items_collection[i].end());
+            lr1_to_lalr[(int)i] = found->second;
         }
 
         // build lalr_goto by mapping lr1_goto pairs through lr1_to_lalr
@@ -377,6 +477,7 @@ public:
         buildLR1Collection();
         buildLALRStates();
         buildParsingTable();
+        buildDenseTables();
     }
 
     // printing helpers
@@ -449,88 +550,105 @@ public:
         cout << string(80, '=') << "\n\n";
     }
 
-    vector< tuple<string,string,string> > parse(const string &input_str) {
-        // tokenization: treat every character as a token (like the python original).
-        vector<string> tokens;
-        for (char c : input_str) {
-            string s(1,c);
-            tokens.push_back(s);
+    // Dense integer tables used by parse(): terminal and nonterminal IDs
+    // index flat arrays instead of the string-keyed maps above.
+    enum { ACT_ERROR = 0, ACT_SHIFT = 1, ACT_REDUCE = 2, ACT_ACCEPT = 3 };
+    vector<string> terminal_names;    // terminal ID -> name; "$" is last
+    vector<string> nonterminal_names; // nonterminal ID -> name
+    vector<int> dense_action;         // [state * terminals + terminal] -> (arg << 2) | ACT_*
+    vector<int> dense_goto;           // [state * nonterminals + nonterminal] -> state, or -1
+    vector<int> prod_head, prod_length;
+
+    void buildDenseTables() {
+        terminal_names.assign(terminals.begin(), terminals.end());
+        terminal_names.push_back("$");
+        nonterminal_names.assign(non_terminals.begin(), non_terminals.end());
+        map<string,int> term_id, nt_id;
+        for (size_t i=0;i<terminal_names.size();++i) term_id[terminal_names[i]] = (int)i;
+        for (size_t i=0;i<nonterminal_names.size();++i) nt_id[nonterminal_names[i]] = (int)i;
+
+        size_t T = terminal_names.size(), N = nonterminal_names.size();
+        dense_action.assign(lalr_states.size() * T, ACT_ERROR);
+        dense_goto.assign(lalr_states.size() * N, -1);
+        for (size_t st=0;st<lalr_states.size();++st) {
+            for (auto &kv : action_table[st]) {
+                int code = ACT_ACCEPT;
+                if (kv.second[0] == 's') code = stoi(kv.second.substr(1)) << 2 | ACT_SHIFT;
+                else if (kv.second[0] == 'r') code = stoi(kv.second.substr(1)) << 2 | ACT_REDUCE;
+                dense_action[st * T + term_id[kv.first]] = code;
+            }
+            for (auto &kv : goto_table[st]) dense_goto[st * N + nt_id[kv.first]] = kv.second;
         }
-        tokens.push_back("$");
 
-        // stacks: states and symbols
-        vector<int> stateStack;
-        vector<string> symbolStack;
-        stateStack.push_back(0);
+        prod_head.clear();
+        prod_length.clear();
+        for (auto &prod : augmented_grammar) {
+            prod_head.push_back(nt_id.count(prod.first) ? nt_id[prod.first] : -1);
+            prod_length.push_back((int)prod.second.size());
+        }
+    }
 
-        size_t pointer = 0;
-        vector< tuple<string,string,string> > trace;
+    // (state stack, symbol stack, description of the action about to be taken)
+    using StepCallback = function<void(const vector<int>&, const vector<int>&, const string&)>;
+
+    // Parses terminal IDs pulled one at a time from in. Only the parse stacks
+    // are kept, so memory does not grow with the length of the input. Symbol
+    // stack entries are terminal IDs, or terminal count + nonterminal ID.
+    bool parse(TokenStream &in, const StepCallback &onStep = nullptr) {
+        const int T = (int)terminal_names.size(), N = (int)nonterminal_names.size();
+        vector<int> stateStack = {0};
+        vector<int> symbolStack;
+        int lookahead = in.next();
 
         while (true) {
             int state = stateStack.back();
-            string sym = tokens[pointer];
-
-            // check if symbol present in any action column, else error
-            // if not present, syntax error
-            string action = "";
-            auto itAction = action_table[state].find(sym);
-            if (itAction != action_table[state].end()) action = itAction->second;
-            if (action.empty()) {
-                trace.push_back({stackToStr(stateStack, symbolStack), joinTokens(tokens, pointer), string("Error: Invalid Syntax")});
-                break;
-            }
-
-            trace.push_back({stackToStr(stateStack, symbolStack), joinTokens(tokens, pointer), actionDescription(action)});
-
-            if (action.rfind("s",0) == 0) {
-                int nxt = stoi(action.substr(1));
-                symbolStack.push_back(sym);
-                stateStack.push_back(nxt);
-                pointer++;
-            } else if (action.rfind("r",0) == 0) {
-                int prod_num = stoi(action.substr(1));
-                auto prod = augmented_grammar[prod_num];
-                vector<string> body = prod.second;
-                int toPop = (int)body.size();
+            int action = lookahead < T ? dense_action[state * T + lookahead] : (int)ACT_ERROR;
+            if (onStep) onStep(stateStack, symbolStack, actionDescription(action));
+
+            if ((action & 3) == ACT_SHIFT) {
+                symbolStack.push_back(lookahead);
+                stateStack.push_back(action >> 2);
+                lookahead = in.next();
+            } else if ((action & 3) == ACT_REDUCE) {
+                int prod_num = action >> 2;
                 // pop symbol and state for each body symbol
-                for (int k=0;k<toPop;k++) {
-                    if (!symbolStack.empty()) symbolStack.pop_back();
-                    if (!stateStack.empty()) stateStack.pop_back();
-                }
-                // after popping, top state is prev_state
-                int prev_state = stateStack.back();
-                string head = prod.first;
-                // find goto
-                int goto_state = -1;
-                auto itGoto = goto_table[prev_state].find(head);
-                if (itGoto != goto_table[prev_state].end()) goto_state = itGoto->second;
+                int toPop = min(prod_length[prod_num], (int)symbolStack.size());
+                stateStack.resize(stateStack.size() - toPop);
+                symbolStack.resize(symbolStack.size() - toPop);
+                int head = prod_head[prod_num];
+                int goto_state = dense_goto[stateStack.back() * N + head];
                 if (goto_state == -1) {
-                    trace.push_back({stackToStr(stateStack, symbolStack), joinTokens(tokens, pointer), string("Error: No GOTO for ") + head});
-                    break;
+                    if (onStep) onStep(stateStack, symbolStack, "Error: No GOTO for " + nonterminal_names[head]);
+                    return false;
                 }
-                symbolStack.push_back(head);
+                symbolStack.push_back(T + head);
                 stateStack.push_back(goto_state);
-            } else if (action == "accept") {
-                trace.push_back({stackToStr(stateStack, symbolStack), joinTokens(tokens, pointer), string("Accept")});
-                break;
             } else {
-                trace.push_back({stackToStr(stateStack, symbolStack), joinTokens(tokens, pointer), string("Error: Invalid Syntax")});
-                break;
+                return action == ACT_ACCEPT;
             }
         }
+    }
 
+    // Parses input_str and returns one (stack, input buffer, action) row per step.
+    vector< tuple<string,string,string> > parse(const string &input_str) {
+        GrammarLexer lexer(input_str, terminal_names);
+        vector< tuple<string,string,string> > trace;
+        parse(lexer, [&](const vector<int> &states, const vector<int> &syms, const string &action) {
+            trace.push_back({stackToStr(states, syms), string(lexer.remaining()) + "$", action});
+        });
         return trace;
     }
 
 private:
-    string stackToStr(const vector<int>& states, const vector<string>& syms) {
+    string stackToStr(const vector<int>& states, const vector<int>& syms) {
         // produce combined stack representation like "0 c 4 c 4"
         // We'll interleave state and symbol: initial state then (symbol state) pairs
+        const int T = (int)terminal_names.size();
         string s;
         if (!states.empty()) s += to_string(states[0]);
         for (size_t i=0;i<syms.size();++i) {
             s += " ";
-            s += syms[i];
+            s += syms[i] < T ? terminal_names[syms[i]] : nonterminal_names[syms[i] - T];
             s += " ";
             if (i+1 < states.size()) s += to_string(states[i+1]);
             else s += "?";
@@ -538,29 +656,22 @@ private:
         return s;
     }
 
-    string joinTokens(const vector<string>& tokens, size_t pointer) {
-        string s;
-        for (size_t i=pointer;i<tokens.size();++i) s += tokens[i];
-        return s;
-    }
-
-    string actionDescription(const string &action) {
-        if (action.rfind("s",0) == 0) {
-            return string("Shift ") + action.substr(1);
+    string actionDescription(int action) {
+        if ((action & 3) == ACT_SHIFT) {
+            return string("Shift ") + to_string(action >> 2);
         }
-        if (action.rfind("r",0) == 0) {
-            int prod_num = stoi(action.substr(1));
-            auto prod = augmented_grammar[prod_num];
+        if ((action & 3) == ACT_REDUCE) {
+            auto prod = augmented_grammar[action >> 2];
             string b = prod.second.empty() ? string("ε") : joinVec(prod.second);
             return string("Reduce by ") + prod.first + " -> " + b;
         }
-        if (action == "accept") return "Accept";
-        return "Error";
+        if (action == ACT_ACCEPT) return "Accept";
+        return "Error: Invalid Syntax";
     }
 };
 
 
-int main() {
+int main(int argc, char* argv[]) {
     // Example grammar from the Python example:
     // S -> C C
     // C -> c C
@@ -573,6 +684,65 @@ int main() {
     string start_symbol = "S";
     string input_str = "ccdd";
 
+    // lalr <file> and lalr --memory-check parse a list of such statements.
+    // The list and the c's of each C are left-recursive, so the parse stack
+    // stays a few entries deep however long the input is:
+    // P -> P S | S,  S -> C C,  C -> X d | d,  X -> X c | c
+    vector<pair<string,string>> statement_grammar = {
+        {"P", "P S"},
+        {"P", "S"},
+        {"S", "C C"},
+        {"C", "X d"},
+        {"C", "d"},
+        {"X", "X c"},
+        {"X", "c"}
+    };
+    auto peakRssKB = [] {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss;
+    };
+
+    // lalr --memory-check: parse the same statements 1k and 1M times from a
+    // token stream that holds nothing but one statement, and check that
+    // peak RSS does not follow the input size
+    if (argc > 1 && string(argv[1]) == "--memory-check") {
+        LALRParser parser(statement_grammar, "P");
+        parser.generate();
+        string unit = "ccccccccd ccccd\n";
+        long rss[2];
+        long long counts[2] = {1000, 1000000};
+        for (int i = 0; i < 2; ++i) {
+            RepeatedInput in(unit, parser.terminal_names, counts[i]);
+            bool accepted = parser.parse(in);
+            rss[i] = peakRssKB();
+            cout << setw(8) << counts[i] * unit.size() / 1000 << " KB of input: "
+                 << (accepted ? "Accepted" : "Syntax error") << ", peak RSS " << rss[i] << " KB\n";
+            if (!accepted) return 1;
+        }
+        if (rss[1] - rss[0] > 1024) {
+            cerr << "Warning: peak RSS grew by " << rss[1] - rss[0] << " KB with the input\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    // lalr <file>: lex and parse the file in one pass without a trace
+    if (argc > 1) {
+        LALRParser parser(statement_grammar, "P");
+        parser.generate();
+        MappedFile file(argv[1]);
+        if (!file.is_open()) {
+            cerr << "Error: Could not open " << argv[1] << "\n";
+            return 1;
+        }
+        SinglePassInput input(file, parser.terminal_names);
+        bool accepted = parser.parse(input);
+        cout << (accepted ? "Accepted" : "Syntax error") << " after " << input.offset()
+             << " bytes, peak RSS " << peakRssKB() << " KB\n";
+        return accepted ? 0 : 1;
+    }
+
     LALRParser parser(grammar_spec, start_symbol);
     parser.generate();
 
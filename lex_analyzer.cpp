@@ -1,14 +1,37 @@
 #include <iostream>
-#include <fstream>
 #include <sstream>
 #include <regex>
 #include <map>
+#include <memory>
+#include <algorithm>
+#include <random>
 #include <vector>
 #include <iomanip> 
 #include <set>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <string_view>
+#include <mutex>
+#include <malloc.h>
+#include "comment_scan.h"
+#include "concurrent_symbols.h"
+#include "keywords.h"
+#include "mapped_file.h"
+#include "numeric_literal.h"
+#include "parallel_lex.h"
+#include "report_writer.h"
+#include "source_files.h"
+#include "string_interner.h"
+#include "utf8.h"
+#include "xref_index.h"
 
 using namespace std;
 
+enum TokenKind { TK_KEYWORD, TK_IDENTIFIER, TK_INTEGER, TK_FLOAT, TK_LITERAL, TK_OPERATOR, TK_INVALID };
+const char* tokenKindName[] = {"Keyword", "Identifier", "Integer", "Float", "Literal", "Operator/Symbol", "Invalid"};
+
+// One row of the original map-based table, kept for --memory comparisons.
 struct Symbol {
     string lexeme;
     string tokenType;
@@ -16,14 +39,75 @@ struct Symbol {
     set<int> lineUsed;
 };
 
+// Lexemes are interned to dense 32-bit IDs; everything else about a symbol
+// lives in flat arrays indexed by that ID.
+class SymbolTable {
+public:
+    StringInterner names;
+    vector<unsigned char> kind; // TokenKind of the first occurrence
+    vector<int> lineDeclared;
+    vector<pair<uint32_t, int>> usages; // (id, line) in source order, one per line
+    uint64_t tokenCount = 0;            // every add(), including repeats on a line
+
+    uint32_t size() const { return names.size(); }
+
+    // Lines must be added in non-decreasing order.
+    uint32_t add(string_view lexeme, TokenKind type, int line) {
+        ++tokenCount;
+        bool inserted;
+        uint32_t id = names.intern(lexeme, inserted);
+        if (inserted) {
+            kind.push_back(type);
+            lineDeclared.push_back(line);
+            lastLineUsed.push_back(0);
+        }
+        if (lastLineUsed[id] != line) {
+            lastLineUsed[id] = line;
+            usages.push_back({id, line});
+        }
+        return id;
+    }
+
+    // Appends a new symbol without a usage; used by the parallel merge,
+    // which fills usages directly and then calls syncUsages().
+    uint32_t addSymbol(string_view lexeme, TokenKind type, int line) {
+        uint32_t id = names.intern(lexeme);
+        kind.push_back(type);
+        lineDeclared.push_back(line);
+        return id;
+    }
+
+    void syncUsages() {
+        lastLineUsed.assign(size(), 0);
+        for (auto& u : usages) lastLineUsed[u.first] = u.second;
+    }
+
+    // Groups usages by symbol: lines[start[id]..start[id + 1]) are the sorted
+    // lines symbol id is used on.
+    void usageLists(vector<uint32_t>& start, vector<int>& lines) const {
+        start.assign(size() + 1, 0);
+        for (auto& u : usages) ++start[u.first + 1];
+        for (uint32_t id = 0; id < size(); ++id) start[id + 1] += start[id];
+        vector<uint32_t> fill(start.begin(), start.end() - 1);
+        lines.resize(usages.size());
+        for (auto& u : usages) lines[fill[u.first]++] = u.second;
+    }
+
+    size_t memoryUsage() const {
+        return names.memoryUsage() + kind.capacity() + lineDeclared.capacity() * sizeof(int) +
+               lastLineUsed.capacity() * sizeof(int) + usages.capacity() * sizeof(usages[0]);
+    }
+
+private:
+    vector<int> lastLineUsed;
+};
+
 regex identifier("^[a-zA-Z_][a-zA-Z0-9_]*$");
 regex integerRegex("^[0-9]+$");
 regex floatRegex("^[0-9]*\\.[0-9]+$");
 regex literalRegex("^\".*\"$");
 
-vector<string> keywords = {"int", "float", "char", "string", "return", "void", "if", "else", "while", "for"};
-
-map<string, Symbol> symbolTable;
+SymbolTable symbolTable;
 
 vector<string> splitTokens(const string& line) {
     vector<string> tokens;
@@ -36,7 +120,8 @@ vector<string> splitTokens(const string& line) {
 
         if (inLiteral) {
             literal += c;
-            if (c == '"') {
+            if (c == '\\' && i + 1 < line.length()) literal += line[++i];
+            else if (c == '"') {
                 tokens.push_back(literal);
                 inLiteral = false;
                 literal.clear();
@@ -46,13 +131,13 @@ vector<string> splitTokens(const string& line) {
             inLiteral = true;
             literal = "\"";
         }
-        else if (isspace(c)) {
+        else if (isspace((unsigned char)c)) {
             if (!token.empty()) {
                 tokens.push_back(token);
                 token.clear();
             }
         }
-        else if (ispunct(c) && c != '_' && c != '.') {
+        else if (ispunct((unsigned char)c) && c != '_' && c != '.') {
             if (!token.empty()) {
                 tokens.push_back(token);
                 token.clear();
@@ -71,33 +156,164 @@ vector<string> splitTokens(const string& line) {
 
 bool isValidIdentifier(const string& token) {
     if (token.empty()) return false;
-    if (!isalpha(token[0]) && token[0] != '_') return false;
+    if (!isalpha((unsigned char)token[0]) && token[0] != '_') return false;
     for (size_t i = 1; i < token.length(); ++i) {
-        if (!isalnum(token[i]) && token[i] != '_') return false;
+        if (!isalnum((unsigned char)token[i]) && token[i] != '_') return false;
     }
     return true;
 }
 
-bool isKeyword(const string& token) {
-    return find(keywords.begin(), keywords.end(), token) != keywords.end();
+// ---------------- Table-driven scanner ----------------
+// Each byte is mapped to a character class, and a (state x class) transition
+// table recognises identifiers, integers and floats while the word is read.
+// Separators, punctuation and string literals end the current word.
+
+enum CharClass { CC_LETTER, CC_DIGIT, CC_DOT, CC_OTHER, CC_SPACE, CC_PUNCT, CC_QUOTE };
+enum WordState { WS_START, WS_IDENT, WS_INT, WS_DOT, WS_FLOAT, WS_BAD, WS_COUNT };
+const int WORD_CLASSES = CC_OTHER + 1; // classes that continue a word
+
+constexpr array<unsigned char, 256> buildCharClass() {
+    array<unsigned char, 256> cls{};
+    for (int c = 0; c < 256; ++c) {
+        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_') cls[c] = CC_LETTER;
+        else if (c >= '0' && c <= '9') cls[c] = CC_DIGIT;
+        else if (c == '.') cls[c] = CC_DOT;
+        else if (c == '"') cls[c] = CC_QUOTE;
+        else if (c == ' ' || (c >= '\t' && c <= '\r')) cls[c] = CC_SPACE;
+        else if ((c >= '!' && c <= '/') || (c >= ':' && c <= '@') ||
+                 (c >= '[' && c <= '`') || (c >= '{' && c <= '~')) cls[c] = CC_PUNCT;
+        else cls[c] = CC_OTHER; // control characters and non-ASCII bytes
+    }
+    return cls;
+}
+
+constexpr array<array<unsigned char, WORD_CLASSES>, WS_COUNT> buildTransitions() {
+    array<array<unsigned char, WORD_CLASSES>, WS_COUNT> t{};
+    for (auto& row : t)
+        for (auto& next : row) next = WS_BAD;
+    t[WS_START][CC_LETTER] = WS_IDENT;
+    t[WS_START][CC_DIGIT] = WS_INT;
+    t[WS_START][CC_DOT] = WS_DOT;
+    t[WS_IDENT][CC_LETTER] = WS_IDENT;
+    t[WS_IDENT][CC_DIGIT] = WS_IDENT;
+    t[WS_INT][CC_DIGIT] = WS_INT;
+    t[WS_INT][CC_DOT] = WS_DOT;
+    t[WS_DOT][CC_DIGIT] = WS_FLOAT;
+    t[WS_FLOAT][CC_DIGIT] = WS_FLOAT;
+    return t;
 }
 
-void addToSymbolTable(const string& lexeme, const string& type, int line) {
-    if (symbolTable.find(lexeme) == symbolTable.end()) {
-        symbolTable[lexeme] = {lexeme, type, line, {line}};
-    } else {
-        symbolTable[lexeme].lineUsed.insert(line);
+constexpr array<bool, 256> buildOperatorChars() {
+    array<bool, 256> ops{};
+    for (const char* p = "=+-*/{}();,><'"; *p; ++p) ops[(unsigned char)*p] = true;
+    return ops;
+}
+
+constexpr auto charClass = buildCharClass();
+constexpr auto wordTransitions = buildTransitions();
+constexpr auto operatorChars = buildOperatorChars();
+constexpr TokenKind acceptingKind[WS_COUNT] = {TK_INVALID, TK_IDENTIFIER, TK_INTEGER, TK_INVALID, TK_FLOAT, TK_INVALID};
+
+// Scans one line (comments already removed) and calls emit(lexeme, kind) for
+// every token in source order, or emit(lexeme, kind, position) if it takes
+// the token's index in line. A literal that starts in the middle of a word
+// is emitted first and the word continues after it, as splitTokens does.
+template <typename Emit>
+void scanLine(string_view line, Emit&& emit) {
+    const size_t n = line.size();
+    int state = WS_START;
+    size_t wordStart = 0;
+    string spill;          // word text cut by a literal
+    size_t spillStart = 0; // where that word began
+
+    auto report = [&](string_view lexeme, TokenKind kind, size_t position) {
+        if constexpr (is_invocable_v<Emit, string_view, TokenKind, size_t>) emit(lexeme, kind, position);
+        else emit(lexeme, kind);
+    };
+
+    auto endWord = [&](size_t end) {
+        if (state == WS_START) return;
+        TokenKind kind = acceptingKind[state];
+        string_view lexeme = line.substr(wordStart, end - wordStart);
+        size_t position = wordStart;
+        if (!spill.empty()) {
+            spill.append(lexeme);
+            lexeme = spill;
+            position = spillStart;
+        }
+        if (kind == TK_IDENTIFIER && isKeyword(lexeme)) kind = TK_KEYWORD;
+        report(lexeme, kind, position);
+        spill.clear();
+        state = WS_START;
+    };
+
+    size_t i = 0;
+    while (i < n) {
+        unsigned char c = line[i];
+        int cls = charClass[c];
+        if (cls < WORD_CLASSES) {
+            if (state == WS_START) {
+                wordStart = i;
+                // Numbers are scanned whole (their exponent may contain a sign);
+                // anything still attached to them makes the word invalid
+                if (cls != CC_LETTER && startsNumber(line, i)) {
+                    NumericLiteral num = scanNumber(line, i);
+                    i = num.end;
+                    state = num.kind == NUM_INTEGER ? WS_INT : num.kind == NUM_FLOAT ? WS_FLOAT : WS_BAD;
+                    if (i < n && charClass[(unsigned char)line[i]] < WORD_CLASSES) state = WS_BAD;
+                    continue;
+                }
+            }
+            // Non-ASCII: a Unicode identifier character, or an invalid word
+            if (c >= 0x80) {
+                uint32_t cp;
+                size_t len = decodeUtf8(line, i, cp);
+                bool ident = len && (state == WS_START ? isXidStart(cp) : state == WS_IDENT && isXidContinue(cp));
+                state = ident ? WS_IDENT : WS_BAD;
+                i += max<size_t>(len, 1);
+                continue;
+            }
+            state = wordTransitions[state][cls];
+            ++i;
+        } else if (cls == CC_SPACE) {
+            endWord(i);
+            ++i;
+        } else if (cls == CC_PUNCT) {
+            endWord(i);
+            report(line.substr(i, 1), operatorChars[c] ? TK_OPERATOR : TK_INVALID, i);
+            ++i;
+        } else {
+            // Literal: the pending word (if any) resumes after the closing quote
+            if (state != WS_START) {
+                if (spill.empty()) spillStart = wordStart;
+                spill.append(line.substr(wordStart, i - wordStart));
+            }
+            // An escaped quote does not close it, as in the comment scanner
+            size_t close = skipQuoted(line, i);
+            if (close == string_view::npos) {
+                i = n;
+                wordStart = n;
+                break;
+            }
+            string_view literal = line.substr(i, close - i);
+            // std::regex '.' does not match a carriage return
+            report(literal, literal.find('\r') == string_view::npos ? TK_LITERAL : TK_INVALID, i);
+            i = close;
+            wordStart = i;
+        }
     }
+    endWord(n);
 }
 
-string removeSingleLineComments(const string& line) {
-    size_t pos = line.find("//");
-    if (pos != string::npos)
-        return line.substr(0, pos);
-    return line;
+int decimalWidth(long long n) {
+    int width = n < 0 ? 2 : 1;
+    for (n = n < 0 ? -n : n; n >= 10; n /= 10) ++width;
+    return width;
 }
 
-void displaySymbolTable() {
+// Writes the symbol table in lexeme order. Text is the padded table; CSV and
+// JSON Lines give one record per symbol for other tools.
+void displaySymbolTable(ReportFormat format = REPORT_TEXT) {
   
     const string header1 = "Entry No.";
     const string header2 = "Lexeme (Name/Value)";
@@ -111,103 +327,713 @@ void displaySymbolTable() {
     int w4 = header4.length();
     int w5 = header5.length();
 
-    vector<Symbol> entries;
-    for (auto& entry : symbolTable) {
-        entries.push_back(entry.second);
+    // Rows are listed in lexeme order
+    vector<uint32_t> entries(symbolTable.size());
+    for (uint32_t id = 0; id < entries.size(); ++id) entries[id] = id;
+    sort(entries.begin(), entries.end(), [](uint32_t a, uint32_t b) {
+        return symbolTable.names.lexeme(a) < symbolTable.names.lexeme(b);
+    });
+
+    vector<uint32_t> usedStart;
+    vector<int> usedLines;
+    symbolTable.usageLists(usedStart, usedLines);
+
+    cout.flush();
+    ReportWriter out;
+
+    if (format == REPORT_CSV) {
+        out.text("entry,lexeme,token_type,line_declared,lines_used\n");
+        int i = 1;
+        for (uint32_t id : entries) {
+            out.number(i++).put(',').csvField(symbolTable.names.lexeme(id)).put(',')
+               .text(tokenKindName[symbolTable.kind[id]]).put(',').number(symbolTable.lineDeclared[id]).put(',');
+            for (uint32_t u = usedStart[id]; u < usedStart[id + 1]; ++u) {
+                if (u > usedStart[id]) out.put(' ');
+                out.number(usedLines[u]);
+            }
+            out.put('\n');
+        }
+        return;
+    }
+
+    if (format == REPORT_JSONL) {
+        int i = 1;
+        for (uint32_t id : entries) {
+            out.text("{\"entry\":").number(i++).text(",\"lexeme\":").jsonString(symbolTable.names.lexeme(id))
+               .text(",\"token_type\":").jsonString(tokenKindName[symbolTable.kind[id]])
+               .text(",\"line_declared\":").number(symbolTable.lineDeclared[id]).text(",\"lines_used\":[");
+            for (uint32_t u = usedStart[id]; u < usedStart[id + 1]; ++u) {
+                if (u > usedStart[id]) out.put(',');
+                out.number(usedLines[u]);
+            }
+            out.text("]}\n");
+        }
+        return;
+    }
+
+    for (uint32_t id : entries) {
         int usedWidth = 0;
-        for (int l : entry.second.lineUsed)
-            usedWidth += to_string(l).length() + 1;
+        for (uint32_t u = usedStart[id]; u < usedStart[id + 1]; ++u)
+            usedWidth += decimalWidth(usedLines[u]) + 1;
 
         w1 = max(w1, 2);
-        w2 = max(w2, (int)entry.second.lexeme.length());
-        w3 = max(w3, (int)entry.second.tokenType.length());
-        w4 = max(w4, (int)to_string(entry.second.lineDeclared).length());
+        w2 = max(w2, (int)textWidth(symbolTable.names.lexeme(id)));
+        w3 = max(w3, (int)strlen(tokenKindName[symbolTable.kind[id]]));
+        w4 = max(w4, decimalWidth(symbolTable.lineDeclared[id]));
         w5 = max(w5, usedWidth);
     }
 
-    cout << left << setw(w1 + 4) << header1
-         << setw(w2 + 4) << header2
-         << setw(w3 + 4) << header3
-         << setw(w4 + 6) << header4
-         << setw(w5 + 6) << header5 << "\n";
-
-    cout << string(w1 + w2 + w3 + w4 + w5 + 24, '-') << "\n";
+    out.padded(header1, w1 + 4).padded(header2, w2 + 4).padded(header3, w3 + 4)
+       .padded(header4, w4 + 6).padded(header5, w5 + 6).put('\n');
+    out.text(string(w1 + w2 + w3 + w4 + w5 + 24, '-')).put('\n');
 
     int i = 1;
-    for (auto& sym : entries) {
-        cout << left << setw(w1 + 4) << i++
-             << setw(w2 + 4) << sym.lexeme
-             << setw(w3 + 4) << sym.tokenType
-             << setw(w4 + 6) << sym.lineDeclared;
+    for (uint32_t id : entries) {
+        out.padded(i++, w1 + 4)
+           .padded(symbolTable.names.lexeme(id), w2 + 4)
+           .padded(tokenKindName[symbolTable.kind[id]], w3 + 4)
+           .padded(symbolTable.lineDeclared[id], w4 + 6);
 
-        stringstream ss;
-        for (int l : sym.lineUsed) ss << l << " ";
-        cout << setw(w5 + 6) << ss.str() << "\n";
+        int usedWidth = 0;
+        for (uint32_t u = usedStart[id]; u < usedStart[id + 1]; ++u) {
+            out.number(usedLines[u]).put(' ');
+            usedWidth += decimalWidth(usedLines[u]) + 1;
+        }
+        out.spaces(max(w5 + 6 - usedWidth, 0)).put('\n');
     }
 }
 
-int main() {
-    ifstream file("test_input.cpp");
-    if (!file.is_open()) {
-        cerr << "Failed to open file.\n";
-        return 1;
+// Reference classifier used before the table-driven scanner; kept for --bench.
+TokenKind classifyTokenRegex(const string& token) {
+    if (isKeyword(token)) return TK_KEYWORD;
+    if (isValidIdentifier(token)) return TK_IDENTIFIER;
+    if (regex_match(token, identifier)) return TK_INVALID;
+    if (regex_match(token, integerRegex)) return TK_INTEGER;
+    if (regex_match(token, floatRegex)) return TK_FLOAT;
+    if (regex_match(token, literalRegex)) return TK_LITERAL;
+    if (token.length() == 1 && operatorChars[(unsigned char)token[0]]) return TK_OPERATOR;
+    return TK_INVALID;
+}
+
+// Lexes source into table, reporting lexical errors to errors.
+bool lexSource(string_view source, SymbolTable& table, ostream& errors,
+               int firstLine = 1, bool inMultilineComment = false) {
+    return forEachCodeSpan(source, [&](int lineNo, string_view line) {
+        scanLine(line, [&](string_view lexeme, TokenKind kind) {
+            if (kind == TK_INVALID)
+                errors << "Lexical Error at line " << lineNo << ": Unrecognized token '" << lexeme << "'\n";
+            else
+                table.add(lexeme, kind, lineNo);
+        });
+    }, firstLine, inMultilineComment);
+}
+
+// Lexes chunks of source on `threads` threads into private tables and
+// merges them into table, which must be empty. The workers publish their
+// symbols to one ConcurrentSymbolTable, where the lowest line wins the
+// declaration, then copy their usages, renumbered to the shared IDs, into
+// table at precomputed offsets. Symbols, usages and error order are exactly
+// those of a serial run.
+void lexSourceParallel(string_view source, int threads, SymbolTable& table, ostream& errors) {
+    using Entry = ConcurrentSymbolTable::Entry;
+    struct ChunkResult {
+        SymbolTable table;
+        ostringstream errors;
+        vector<Entry*> shared; // local ID -> shared entry
+    };
+    auto results = lexInParallel<ChunkResult>(source, threads,
+        [](const SourceChunk& chunk, bool inComment, ChunkResult& r) {
+            return lexSource(chunk.text, r.table, r.errors, chunk.firstLine, inComment);
+        });
+
+    size_t localSymbols = 0;
+    for (auto& r : results) localSymbols += r.table.size();
+    ConcurrentSymbolTable shared(localSymbols);
+    runOnWorkers(results.size(), threads, [&](size_t c) {
+        SymbolTable& local = results[c].table;
+        results[c].shared.resize(local.size());
+        for (uint32_t id = 0; id < local.size(); ++id)
+            results[c].shared[id] = shared.insert(local.names.lexeme(id), local.kind[id], local.lineDeclared[id]);
+    });
+
+    // Number the shared symbols by declaration line, then lexeme, so IDs do
+    // not depend on which thread won an insert race
+    vector<Entry*> entries;
+    entries.reserve(shared.size());
+    shared.forEach([&](Entry& e) { entries.push_back(&e); });
+    sort(entries.begin(), entries.end(), [](const Entry* a, const Entry* b) {
+        uint64_t la = a->firstSeen.load(memory_order_relaxed), lb = b->firstSeen.load(memory_order_relaxed);
+        return la != lb ? la < lb : a->lexeme < b->lexeme;
+    });
+    for (Entry* e : entries)
+        e->id = table.addSymbol(e->lexeme, (TokenKind)e->kind, e->firstSeen.load(memory_order_relaxed));
+
+    // Chunks are in source order, so their usage lists simply concatenate
+    vector<size_t> offset(results.size() + 1, 0);
+    for (size_t c = 0; c < results.size(); ++c) offset[c + 1] = offset[c] + results[c].table.usages.size();
+    table.usages.resize(offset.back());
+    runOnWorkers(results.size(), threads, [&](size_t c) {
+        auto out = table.usages.begin() + offset[c];
+        for (auto& u : results[c].table.usages) *out++ = {results[c].shared[u.first]->id, u.second};
+    });
+    table.syncUsages();
+
+    for (auto& r : results) {
+        table.tokenCount += r.table.tokenCount;
+        errors << r.errors.str();
     }
+}
 
-    string line;
-    int lineNo = 0;
-    bool inMultilineComment = false;
+// Inserts every token of source into a shared table from 1, 2, 4 ... up to
+// `threads` threads, lock-free and through one mutex-guarded SymbolTable.
+void runInsertBenchmark(string_view source, int threads) {
+    using Clock = chrono::steady_clock;
+    StringInterner pool;
+    vector<uint32_t> ids;
+    vector<int> lines;
+    vector<unsigned char> kinds;
+    forEachCodeSpan(source, [&](int lineNo, string_view line) {
+        scanLine(line, [&](string_view lexeme, TokenKind kind) {
+            if (kind == TK_INVALID) return;
+            ids.push_back(pool.intern(lexeme));
+            lines.push_back(lineNo);
+            kinds.push_back(kind);
+        });
+    });
+    vector<string_view> tokens(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) tokens[i] = pool.lexeme(ids[i]);
 
-    while (getline(file, line)) {
-        ++lineNo;
+    // Runs insert(i) for every token, split evenly over t threads
+    auto timeInserts = [&](int t, auto&& insert) {
+        auto start = Clock::now();
+        runOnWorkers(t, t, [&](size_t w) {
+            for (size_t i = tokens.size() * w / t, end = tokens.size() * (w + 1) / t; i < end; ++i) insert(i);
+        });
+        return tokens.size() / chrono::duration<double>(Clock::now() - start).count() / 1e6;
+    };
 
-        if (inMultilineComment) {
-            if (line.find("*/") != string::npos)
-                inMultilineComment = false;
-            continue;
-        }
+    cout << "\nShared symbol inserts (" << tokens.size() << " tokens, " << pool.size() << " symbols)\n";
+    cout << left << setw(10) << "Threads" << setw(20) << "Lock-free (M/s)" << "Mutex (M/s)\n";
+    for (int t = 1;; t = min(t * 2, threads)) {
+        ConcurrentSymbolTable shared(pool.size());
+        double lockFree = timeInserts(t, [&](size_t i) { shared.insert(tokens[i], kinds[i], lines[i]); });
 
-        if (line.find("/*") != string::npos) {
-            inMultilineComment = true;
-            continue;
-        }
+        SymbolTable locked;
+        mutex lock;
+        double withMutex = timeInserts(t, [&](size_t i) {
+            lock_guard<mutex> guard(lock);
+            locked.add(tokens[i], (TokenKind)kinds[i], lines[i]);
+        });
 
-        line = removeSingleLineComments(line);
-        vector<string> tokens = splitTokens(line);
+        cout << setw(10) << t << fixed << setprecision(1) << setw(20) << lockFree << withMutex << "\n";
+        if (shared.size() != pool.size()) cerr << "Warning: shared table lost symbols\n";
+        if (t == threads) break;
+    }
+}
 
-        for (string token : tokens) {
-            if (token.empty()) continue;
+// Compares tokens/sec of the regex classifier and the table-driven scanner,
+// then the per-token cost of keyword lookup by linear scan and perfect hash.
+void runBenchmark(string_view source) {
+    using Clock = chrono::steady_clock;
+    const double minSeconds = 0.5;
 
-            if (isKeyword(token)) {
-                addToSymbolTable(token, "Keyword", lineNo);
-                continue;
-            }
-            else if (isValidIdentifier(token)) {
-                addToSymbolTable(token, "Identifier", lineNo);
-            }
-            else if (regex_match(token, identifier)) {
-                cerr << "Lexical Error at line " << lineNo << ": Invalid identifier name '" << token << "'\n";
-            }
-            else if (regex_match(token, integerRegex)) {
-                addToSymbolTable(token, "Integer", lineNo);
-            }
-            else if (regex_match(token, floatRegex)) {
-                addToSymbolTable(token, "Float", lineNo);
-            }
-            else if (regex_match(token, literalRegex)) {
-                addToSymbolTable(token, "Literal", lineNo);
+    auto measure = [&](const char* name, auto&& lexAll) {
+        size_t tokens = 0, kindSum = 0;
+        int rounds = 0;
+        auto start = Clock::now();
+        double elapsed = 0;
+        do {
+            lexAll(tokens, kindSum);
+            ++rounds;
+            elapsed = chrono::duration<double>(Clock::now() - start).count();
+        } while (elapsed < minSeconds);
+        double perSec = tokens / elapsed;
+        cout << left << setw(14) << name << tokens / rounds << " tokens/pass, "
+             << fixed << setprecision(0) << perSec << " tokens/sec\n";
+        return make_pair(perSec, kindSum / rounds);
+    };
+
+    auto regexPath = measure("regex", [&](size_t& tokens, size_t& kindSum) {
+        forEachCodeSpan(source, [&](int, string_view line) {
+            for (const string& token : splitTokens(string(line))) {
+                kindSum += classifyTokenRegex(token);
+                ++tokens;
             }
-            else if (token == "=" || token == "+" || token == "-" || token == "*" || token == "/" ||
-                     token == "{" || token == "}" || token == "(" || token == ")" || 
-                     token == ";" || token == "," || token == ">"|| token == "<"|| token == "'") {
-                addToSymbolTable(token, "Operator/Symbol", lineNo);
+        });
+    });
+    auto tablePath = measure("table-driven", [&](size_t& tokens, size_t& kindSum) {
+        forEachCodeSpan(source, [&](int, string_view line) {
+            scanLine(line, [&](string_view, TokenKind kind) {
+                kindSum += kind;
+                ++tokens;
+            });
+        });
+    });
+
+    cout << "Speedup       : " << setprecision(1) << tablePath.first / regexPath.first << "x\n";
+    if (regexPath.second != tablePath.second)
+        cerr << "Warning: scanners disagree on token classification"
+                " (the regexes only accept plain decimal numbers)\n";
+
+    // Keyword lookup alone, over every identifier-shaped token in the input
+    vector<string_view> words;
+    forEachCodeSpan(source, [&](int, string_view line) {
+        scanLine(line, [&](string_view lexeme, TokenKind kind) {
+            if (kind == TK_KEYWORD || kind == TK_IDENTIFIER) words.push_back(lexeme);
+        });
+    });
+    if (words.empty()) return;
+
+    vector<string> keywordList(keywordSpelling + 1, keywordSpelling + KW_COUNT);
+    auto lookupCost = [&](const char* name, auto&& isKw) {
+        size_t hits = 0, lookups = 0;
+        auto start = Clock::now();
+        double elapsed = 0;
+        do {
+            for (string_view w : words) hits += isKw(w);
+            lookups += words.size();
+            elapsed = chrono::duration<double>(Clock::now() - start).count();
+        } while (elapsed < minSeconds);
+        cout << left << setw(14) << name << setprecision(2) << elapsed * 1e9 / lookups << " ns/token\n";
+        return hits * words.size() / lookups;
+    };
+    size_t linearHits = lookupCost("linear scan", [&](string_view w) {
+        return find(keywordList.begin(), keywordList.end(), w) != keywordList.end();
+    });
+    size_t hashHits = lookupCost("perfect hash", [](string_view w) { return isKeyword(w); });
+    if (linearHits != hashHits)
+        cerr << "Warning: keyword lookups disagree\n";
+}
+
+// ---------------- Incremental re-lexing ----------------
+// Keeps the tokens of every line and whether the line ends inside a
+// multi-line comment. An edit re-lexes from its first line and stops as soon
+// as a line past the edit ends in the same state as before, since nothing
+// after that line can change. Tokens are stored as interned IDs, and each
+// symbol keeps the set of lines it is used on, ordered by line index, so
+// re-lexing a line updates only that line's symbols. Lines shifted by an
+// insert or delete keep their relative order, which is all the sets depend
+// on, so declaration and usage lines stay exact.
+class IncrementalLexer {
+public:
+    explicit IncrementalLexer(string_view source) {
+        forEachLine(source, [&](int, string_view line) {
+            lines.push_back(make_unique<Line>(Line{string(line), false, {}, lines.size()}));
+        });
+        bool state = false;
+        for (size_t i = 0; i < lines.size(); ++i) state = lexLine(i, state);
+    }
+
+    // Replaces `count` lines starting at firstLine (1-based) with newLines.
+    // Returns how many lines had to be lexed again.
+    size_t edit(int firstLine, int count, const vector<string>& newLines) {
+        size_t start = min<size_t>(max(firstLine, 1) - 1, lines.size());
+        size_t end = min(lines.size(), start + max(count, 0));
+        bool state = start > 0 ? lines[start - 1]->endsInComment : false;
+        // State the first line after the edit used to start in
+        bool oldState = end > start ? lines[end - 1]->endsInComment : state;
+
+        // Overwrite in place where possible; only a change in the number of
+        // lines shifts the lines below the edit
+        size_t common = min(end - start, newLines.size());
+        for (size_t k = 0; k < common; ++k) lines[start + k]->text = newLines[k];
+        for (size_t k = start + common; k < end; ++k) release(*lines[k]);
+        lines.erase(lines.begin() + start + common, lines.begin() + end);
+        vector<unique_ptr<Line>> inserted;
+        for (size_t k = common; k < newLines.size(); ++k)
+            inserted.push_back(make_unique<Line>(Line{newLines[k], false, {}, 0}));
+        lines.insert(lines.begin() + start + common, make_move_iterator(inserted.begin()),
+                     make_move_iterator(inserted.end()));
+        if (end - start != newLines.size())
+            for (size_t k = start + common; k < lines.size(); ++k) lines[k]->index = k;
+
+        size_t i = start, editedEnd = start + newLines.size();
+        for (; i < editedEnd; ++i) state = lexLine(i, state);
+        // Old lines keep their tokens once they start in their old state again
+        while (i < lines.size() && state != oldState) {
+            oldState = lines[i]->endsInComment;
+            state = lexLine(i++, state);
+        }
+        if (deadSymbols > 1024 && deadSymbols * 2 > names.size()) compact();
+        return i - start;
+    }
+
+    // Lines (1-based, increasing) that lexeme is used on; the first is where
+    // it is declared. Empty if the text does not use it. Costs one lookup
+    // plus the size of the answer, whatever the size of the file.
+    vector<int> linesUsed(string_view lexeme) const {
+        vector<int> out;
+        uint32_t id = names.find(lexeme);
+        if (id == StringInterner::NOT_FOUND) return out;
+        for (const Line* line : usedOn[id]) out.push_back(line->index + 1);
+        return out;
+    }
+
+    // Rebuilds the symbol table and lexical errors of the whole text, exactly
+    // as lexSource would produce them.
+    void snapshot(SymbolTable& table, ostream& errors) const {
+        for (size_t i = 0; i < lines.size(); ++i) {
+            int lineNo = i + 1;
+            for (uint32_t id : lines[i]->tokens) {
+                TokenKind kind = (TokenKind)kinds[id];
+                if (kind == TK_INVALID)
+                    errors << "Lexical Error at line " << lineNo << ": Unrecognized token '" << names.lexeme(id) << "'\n";
+                else
+                    table.add(names.lexeme(id), kind, lineNo);
             }
-            else {
-                cerr << "Lexical Error at line " << lineNo << ": Unrecognized token '" << token << "'\n";
+        }
+    }
+
+    string text() const {
+        string out;
+        for (auto& line : lines) out.append(line->text).push_back('\n');
+        return out;
+    }
+
+    size_t lineCount() const { return lines.size(); }
+    const string& line(size_t i) const { return lines[i]->text; }
+    // Interned lexemes, including those no longer used until the next compaction.
+    uint32_t internedCount() const { return names.size(); }
+
+private:
+    struct Line {
+        string text;
+        bool endsInComment;
+        vector<uint32_t> tokens; // interned lexemes, in source order
+        size_t index;            // position in lines
+    };
+
+    struct ByIndex {
+        bool operator()(const Line* a, const Line* b) const { return a->index < b->index; }
+    };
+
+    // Lines are boxed so the usage sets can point at them across shifts
+    vector<unique_ptr<Line>> lines;
+    StringInterner names;
+    vector<unsigned char> kinds;            // TokenKind per interned lexeme
+    vector<uint32_t> occurrences;           // tokens per lexeme in the whole text
+    vector<set<const Line*, ByIndex>> usedOn; // lines using each symbol (not errors)
+    uint32_t deadSymbols = 0;               // interned lexemes with no occurrences
+
+    // Removes the contributions of line's tokens.
+    void release(const Line& line) {
+        for (uint32_t id : line.tokens) {
+            usedOn[id].erase(&line);
+            if (--occurrences[id] == 0) ++deadSymbols;
+        }
+    }
+
+    bool lexLine(size_t i, bool inComment) {
+        Line& line = *lines[i];
+        release(line);
+        line.tokens.clear();
+        inComment = forEachCodeSegment(line.text, inComment, [&](string_view code) {
+            scanLine(code, [&](string_view lexeme, TokenKind kind) {
+                bool inserted;
+                uint32_t id = names.intern(lexeme, inserted);
+                if (inserted) {
+                    kinds.push_back(kind);
+                    occurrences.push_back(0);
+                    usedOn.emplace_back();
+                }
+                if (occurrences[id]++ == 0 && !inserted) --deadSymbols;
+                if (kinds[id] != TK_INVALID) usedOn[id].insert(&line);
+                line.tokens.push_back(id);
+            });
+        });
+        line.endsInComment = inComment;
+        return inComment;
+    }
+
+    // Drops lexemes no line uses any more and renumbers the rest. Runs once
+    // at least half of the interned lexemes are dead, so its O(file) cost is
+    // spread over as many edits as there were symbols removed.
+    void compact() {
+        StringInterner live;
+        vector<uint32_t> newId(names.size(), StringInterner::NOT_FOUND);
+        vector<unsigned char> liveKinds;
+        vector<uint32_t> liveOccurrences;
+        vector<set<const Line*, ByIndex>> liveUsedOn;
+        for (uint32_t id = 0; id < names.size(); ++id) {
+            if (occurrences[id] == 0) continue;
+            newId[id] = live.intern(names.lexeme(id));
+            liveKinds.push_back(kinds[id]);
+            liveOccurrences.push_back(occurrences[id]);
+            liveUsedOn.push_back(move(usedOn[id]));
+        }
+        for (auto& line : lines)
+            for (uint32_t& id : line->tokens) id = newId[id];
+        names = move(live);
+        kinds = move(liveKinds);
+        occurrences = move(liveOccurrences);
+        usedOn = move(liveUsedOn);
+        deadSymbols = 0;
+    }
+};
+
+// Applies random single-line edits (with occasional line inserts and
+// deletes) and reports the average cost per edit. The final incremental
+// state is checked against a full re-lex of the edited text.
+void runEditBenchmark(string_view source) {
+    using Clock = chrono::steady_clock;
+    IncrementalLexer lexer(source);
+    if (lexer.lineCount() == 0) return;
+
+    mt19937 rng(12345);
+    const int edits = 10000;
+    size_t relexed = 0;
+    int changedCount = 0;
+    double inPlaceSeconds = 0, changedSeconds = 0;
+    for (int e = 0; e < edits; ++e) {
+        int lineNo = rng() % lexer.lineCount() + 1;
+        string text = lexer.line(lineNo - 1);
+        int op = rng() % 10;
+        auto start = Clock::now();
+        if (op == 0)
+            relexed += lexer.edit(lineNo, 0, {"int edit_" + to_string(e) + " = " + to_string(e) + ";"});
+        else if (op == 1 && lexer.lineCount() > 1)
+            relexed += lexer.edit(lineNo, 1, {});
+        else
+            relexed += lexer.edit(lineNo, 1, {text + " edit_" + to_string(e % 100)});
+        double elapsed = chrono::duration<double>(Clock::now() - start).count();
+        if (op <= 1) {
+            changedSeconds += elapsed;
+            ++changedCount;
+        } else {
+            inPlaceSeconds += elapsed;
+        }
+    }
+
+    cout << "Lines         : " << lexer.lineCount() << "\n";
+    cout << "Edits         : " << edits << "\n";
+    cout << "Lines re-lexed: " << fixed << setprecision(2) << (double)relexed / edits << " per edit\n";
+    cout << "In-place edit : " << inPlaceSeconds * 1e6 / max(edits - changedCount, 1) << " us\n";
+    cout << "Insert/delete : " << changedSeconds * 1e6 / max(changedCount, 1) << " us\n";
+
+    SymbolTable incremental, full;
+    ostringstream incrementalErrors, fullErrors;
+    lexer.snapshot(incremental, incrementalErrors);
+    string text = lexer.text();
+    lexSource(text, full, fullErrors);
+    bool same = incremental.size() == full.size() && incremental.usages.size() == full.usages.size() &&
+                incrementalErrors.str() == fullErrors.str();
+    for (size_t u = 0; same && u < full.usages.size(); ++u) {
+        auto a = incremental.usages[u], b = full.usages[u];
+        same = a.second == b.second && incremental.names.lexeme(a.first) == full.names.lexeme(b.first);
+    }
+    // The per-symbol line sets must agree with the full table
+    vector<uint32_t> start;
+    vector<int> usedLines;
+    full.usageLists(start, usedLines);
+    auto queryStart = Clock::now();
+    for (uint32_t id = 0; same && id < full.size(); ++id) {
+        vector<int> lines = lexer.linesUsed(full.names.lexeme(id));
+        same = lines.size() == start[id + 1] - start[id] && equal(lines.begin(), lines.end(), usedLines.begin() + start[id]) &&
+               lines[0] == full.lineDeclared[id];
+    }
+    double querySeconds = chrono::duration<double>(Clock::now() - queryStart).count();
+    cout << "Symbol query  : " << querySeconds * 1e6 / max<uint32_t>(full.size(), 1) << " us\n";
+    cout << "Interned      : " << lexer.internedCount() << " lexemes, " << full.size() << " symbols in use\n";
+    if (!same)
+        cerr << "Warning: incremental symbol table differs from a full re-lex\n";
+}
+
+// Heap bytes held by the original map<string, Symbol> and by the interned
+// table after lexing the same source, measured with mallinfo2.
+void reportMemoryUse(string_view source) {
+    auto heapInUse = []() { return (size_t)mallinfo2().uordblks; };
+
+    size_t before = heapInUse();
+    auto legacy = make_unique<map<string, Symbol>>();
+    forEachCodeSpan(source, [&](int lineNo, string_view line) {
+        scanLine(line, [&](string_view lexeme, TokenKind kind) {
+            if (kind == TK_INVALID) return;
+            string key(lexeme);
+            auto it = legacy->find(key);
+            if (it == legacy->end())
+                (*legacy)[key] = {key, tokenKindName[kind], lineNo, {lineNo}};
+            else
+                it->second.lineUsed.insert(lineNo);
+        });
+    });
+    size_t legacyBytes = heapInUse() - before;
+    size_t symbols = legacy->size();
+    legacy.reset();
+
+    before = heapInUse();
+    auto interned = make_unique<SymbolTable>();
+    forEachCodeSpan(source, [&](int lineNo, string_view line) {
+        scanLine(line, [&](string_view lexeme, TokenKind kind) {
+            if (kind != TK_INVALID) interned->add(lexeme, kind, lineNo);
+        });
+    });
+    size_t internedBytes = heapInUse() - before;
+
+    cout << "Symbols           : " << symbols << "\n";
+    cout << "map<string,Symbol>: " << legacyBytes << " bytes (" << legacyBytes / max<size_t>(symbols, 1) << " per symbol)\n";
+    cout << "Interned table    : " << internedBytes << " bytes (" << internedBytes / max<size_t>(symbols, 1) << " per symbol)\n";
+}
+
+// Lexes every file on `threads` workers and saves a cross-reference index
+// of all symbol occurrences (the tokens the symbol table would hold) as
+// (file, byte offset). Returns the number of files that could not be opened.
+int buildXrefIndex(const vector<string>& paths, const string& indexPath, int threads) {
+    struct FileSymbols {
+        bool opened = false;
+        StringInterner names;
+        vector<unsigned char> kinds;
+        vector<pair<uint32_t, uint64_t>> occurrences; // (local ID, offset)
+    };
+    vector<string> files = collectSourceFiles(paths);
+    vector<FileSymbols> results(files.size());
+
+    runOnWorkers(files.size(), threads, [&](size_t i) {
+        FileSymbols& r = results[i];
+        MappedFile file(files[i]);
+        if (!(r.opened = file.is_open())) return;
+        string_view source = file.view();
+        forEachCodeSpan(source, [&](int, string_view line) {
+            uint64_t lineStart = line.data() - source.data();
+            scanLine(line, [&](string_view lexeme, TokenKind kind, size_t position) {
+                if (kind == TK_INVALID) return;
+                bool inserted;
+                uint32_t id = r.names.intern(lexeme, inserted);
+                if (inserted) r.kinds.push_back(kind);
+                r.occurrences.push_back({id, lineStart + position});
+            });
+        });
+    });
+
+    XrefBuilder builder;
+    int failed = 0;
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (!results[i].opened) {
+            cerr << files[i] << ": Error opening input file.\n";
+            ++failed;
+        }
+        builder.addFile(files[i], results[i].names, results[i].kinds, move(results[i].occurrences));
+        results[i] = FileSymbols();
+    }
+    if (!builder.save(indexPath)) {
+        cerr << "Failed to write " << indexPath << "\n";
+        return files.size();
+    }
+    cerr << "Indexed " << files.size() - failed << " files: " << builder.symbolCount() << " symbols, "
+         << builder.occurrenceCount() << " occurrences\n";
+    return failed;
+}
+
+// Answers one query against a saved index: every use of a symbol as
+// "path offset" lines, or the symbol at "path:offset". The lookup time goes
+// to stderr so it can be compared across index sizes.
+int queryXrefIndex(const string& indexPath, const string& uses, const string& at) {
+    using Clock = chrono::steady_clock;
+    XrefIndex index(indexPath);
+    if (!index.valid()) {
+        cerr << indexPath << ": not a cross-reference index\n";
+        return 1;
+    }
+    ReportWriter out;
+    auto start = Clock::now();
+    size_t matches = 0;
+    if (!uses.empty()) {
+        uint32_t symbol = index.findSymbol(uses);
+        if (symbol != xref::NOT_FOUND)
+            index.forEachUse(symbol, [&](uint32_t file, uint64_t offset) {
+                out.text(index.fileName(file)).put(' ').number(offset).put('\n');
+                ++matches;
+            });
+    } else {
+        size_t colon = at.rfind(':');
+        uint32_t file = colon == string::npos ? xref::NOT_FOUND : index.findFile(at.substr(0, colon));
+        if (file == xref::NOT_FOUND) {
+            cerr << "Expected PATH:OFFSET with an indexed path, got " << at << "\n";
+            return 1;
+        }
+        uint64_t begin;
+        uint32_t symbol = index.symbolAt(file, strtoull(at.c_str() + colon + 1, nullptr, 10), begin);
+        if (symbol != xref::NOT_FOUND) {
+            out.text(index.lexeme(symbol)).put(' ').text(tokenKindName[index.kind(symbol)])
+               .put(' ').number(begin).put('\n');
+            ++matches;
+        }
+    }
+    double micros = chrono::duration<double, micro>(Clock::now() - start).count();
+    out.flush();
+    cerr << matches << " matches in " << fixed << setprecision(1) << micros << " us\n";
+    return matches ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    bool bench = false, memory = false, editBench = false, countOnly = false;
+    int threads = 1;
+    ReportFormat format = REPORT_TEXT;
+    string path = "test_input.cpp";
+    string xrefSave, xrefPath, uses, at;
+    vector<string> paths;
+    for (int a = 1; a < argc; ++a) {
+        string arg = argv[a];
+        if (arg == "--bench") bench = true;
+        else if (arg == "--memory") memory = true;
+        else if (arg == "--edit-bench") editBench = true;
+        else if (arg == "--count") countOnly = true;
+        else if (arg == "--threads" && a + 1 < argc) threads = max(1, atoi(argv[++a]));
+        else if (arg == "--format" && a + 1 < argc) {
+            if (!parseReportFormat(argv[++a], format)) {
+                cerr << "Unknown format " << argv[a] << " (expected text, csv or jsonl)\n";
+                return 1;
             }
         }
+        else if (arg == "--xref-save" && a + 1 < argc) xrefSave = argv[++a];
+        else if (arg == "--xref" && a + 1 < argc) xrefPath = argv[++a];
+        else if (arg == "--uses" && a + 1 < argc) uses = argv[++a];
+        else if (arg == "--at" && a + 1 < argc) at = argv[++a];
+        else paths.push_back(path = arg);
+    }
+
+    if (!xrefSave.empty()) {
+        if (paths.empty()) paths.push_back(path);
+        return buildXrefIndex(paths, xrefSave, threads) ? 1 : 0;
+    }
+    if (!xrefPath.empty()) {
+        if (uses.empty() == at.empty()) {
+            cerr << "--xref needs exactly one of --uses NAME or --at PATH:OFFSET\n";
+            return 1;
+        }
+        return queryXrefIndex(xrefPath, uses, at);
+    }
+
+    MappedFile file(path);
+    if (!file.is_open()) {
+        cerr << "Failed to open file.\n";
+        return 1;
     }
 
-    displaySymbolTable();
+    if (bench) {
+        runBenchmark(file.view());
+        if (threads > 1) runInsertBenchmark(file.view(), threads);
+        return 0;
+    }
+    if (memory) {
+        reportMemoryUse(file.view());
+        return 0;
+    }
+    if (editBench) {
+        runEditBenchmark(file.view());
+        return 0;
+    }
+
+    reportInvalidUtf8(file.view(), cerr);
+    if (threads > 1)
+        lexSourceParallel(file.view(), threads, symbolTable, cerr);
+    else
+        lexSource(file.view(), symbolTable, cerr);
+
+    if (countOnly) {
+        cout << "Tokens: " << symbolTable.tokenCount << "\n";
+        cout << "Symbols: " << symbolTable.size() << "\n";
+        return 0;
+    }
+    displaySymbolTable(format);
     return 0;
 }
-
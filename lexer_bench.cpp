@@ -0,0 +1,320 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <map>
+#include <random>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+using namespace std;
+
+// Throughput benchmark for the lexers. Generates a synthetic C-like source
+// of the requested size, runs lex_analyzer, exp1 and exp2 over it as child
+// processes and reports MB/s, tokens/s and peak RSS for each. Results can be
+// saved as a baseline and later runs compared against it.
+//
+//   lexer_bench [--size 16M] [--seed 1] [--runs 3] [--bin-dir .]
+//               [--input file | --keep file]
+//               [--save-baseline file] [--baseline file] [--threshold 10]
+
+struct BenchResult {
+    string name;
+    double mbPerSec = 0;
+    double tokensPerSec = 0;
+    long peakRssKB = 0;
+};
+
+long long parseSize(const string& s) {
+    long long n = atoll(s.c_str());
+    switch (s.empty() ? ' ' : toupper(s.back())) {
+        case 'K': return n << 10;
+        case 'M': return n << 20;
+        case 'G': return n << 30;
+        default: return n;
+    }
+}
+
+// ---------------- Synthetic source generator ----------------
+// Emits functions made of declarations, assignments, calls with string
+// literals, if/while blocks and returns, with line comments, doc-block
+// comments and license headers mixed in, roughly in the proportions of
+// ordinary C code.
+
+class SourceGenerator {
+public:
+    explicit SourceGenerator(unsigned seed) : rng(seed) {
+        const char* heads[] = {"count", "index", "value", "buffer", "node", "total", "size", "result",
+                               "offset", "length", "state", "item", "temp", "flag", "ptr", "data"};
+        const char* tails[] = {"", "_a", "_b", "_max", "_min", "_next", "_prev", "_len", "_id", "_tmp"};
+        for (const char* h : heads)
+            for (const char* t : tails)
+                for (int k = 0; k < 4; ++k) identifiers.push_back(string(h) + t + (k ? to_string(k) : ""));
+    }
+
+    // Appends roughly one function to out.
+    void function(string& out) {
+        if (pick(20) == 0) licenseHeader(out);
+        if (pick(3) == 0) docBlock(out);
+        out += type() + " " + ident() + "(" + type() + " " + ident() + ", " + type() + " " + ident() + ") {\n";
+        int statements = 4 + pick(12);
+        for (int s = 0; s < statements; ++s) statement(out, 1);
+        out += "    return " + expr() + ";\n}\n\n";
+    }
+
+private:
+    mt19937 rng;
+    vector<string> identifiers;
+
+    int pick(int n) { return rng() % n; }
+    const string& ident() { return identifiers[pick(identifiers.size())]; }
+    string type() {
+        static const char* types[] = {"int", "int", "float", "char", "double", "void", "bool", "string"};
+        return types[pick(8)];
+    }
+    string number() {
+        return pick(4) == 0 ? to_string(pick(1000)) + "." + to_string(pick(100)) : to_string(pick(10000));
+    }
+    string operand() { return pick(3) == 0 ? number() : ident(); }
+    string expr() {
+        static const char* ops[] = {" + ", " - ", " * ", " / "};
+        string e = operand();
+        for (int n = pick(3); n > 0; --n) e += ops[pick(4)] + operand();
+        return e;
+    }
+    string condition() {
+        static const char* cmp[] = {" < ", " > ", " <= ", " >= ", " == ", " != "};
+        return operand() + cmp[pick(6)] + operand();
+    }
+
+    void statement(string& out, int depth) {
+        string indent(depth * 4, ' ');
+        switch (pick(depth > 2 ? 6 : 8)) {
+            case 0: case 1:
+                out += indent + type() + " " + ident() + " = " + expr() + ";\n";
+                break;
+            case 2: case 3:
+                out += indent + ident() + " = " + expr() + ";";
+                out += pick(4) == 0 ? "  // update " + ident() + "\n" : "\n";
+                break;
+            case 4:
+                out += indent + ident() + "(\"" + ident() + " is %d\", " + ident() + ");\n";
+                break;
+            case 5:
+                out += indent + "// " + ident() + " must be checked before " + ident() + "\n";
+                break;
+            case 6:
+                out += indent + "if (" + condition() + ") {\n";
+                for (int n = 1 + pick(3); n > 0; --n) statement(out, depth + 1);
+                out += indent + "} else {\n";
+                statement(out, depth + 1);
+                out += indent + "}\n";
+                break;
+            default:
+                out += indent + "while (" + condition() + ") {\n";
+                for (int n = 1 + pick(3); n > 0; --n) statement(out, depth + 1);
+                out += indent + "}\n";
+                break;
+        }
+    }
+
+    void docBlock(string& out) {
+        out += "/*\n";
+        for (int n = 1 + pick(4); n > 0; --n) out += " * " + ident() + " updates " + ident() + " from " + ident() + "\n";
+        out += " */\n";
+    }
+
+    void licenseHeader(string& out) {
+        out += "/*\n";
+        for (int n = 0; n < 12; ++n) out += " * Permission is hereby granted, free of charge, to any person obtaining a copy\n";
+        out += " */\n";
+    }
+};
+
+bool generateSource(const string& path, long long bytes, unsigned seed) {
+    ofstream out(path, ios::binary);
+    if (!out) return false;
+    SourceGenerator gen(seed);
+    string block;
+    long long written = 0;
+    while (written < bytes) {
+        block.clear();
+        while (block.size() < (1 << 20) && written + (long long)block.size() < bytes) gen.function(block);
+        out.write(block.data(), block.size());
+        written += block.size();
+    }
+    return (bool)out;
+}
+
+// ---------------- Running the lexers ----------------
+
+// Runs argv with stdout captured and stderr discarded. Returns the last
+// "Tokens" count printed, and fills wall time and peak RSS.
+long long runLexer(const vector<string>& argv, double& seconds, long& peakRssKB) {
+    int out[2];
+    if (pipe(out) != 0) return -1;
+    auto start = chrono::steady_clock::now();
+    pid_t pid = fork();
+    if (pid == 0) {
+        dup2(out[1], STDOUT_FILENO);
+        int devnull = open("/dev/null", O_WRONLY);
+        dup2(devnull, STDERR_FILENO);
+        close(out[0]);
+        vector<char*> args;
+        for (auto& a : argv) args.push_back(const_cast<char*>(a.c_str()));
+        args.push_back(nullptr);
+        execv(args[0], args.data());
+        _exit(127);
+    }
+    close(out[1]);
+
+    string tail;
+    char buf[1 << 16];
+    ssize_t got;
+    while ((got = read(out[0], buf, sizeof buf)) > 0) {
+        tail.append(buf, got);
+        if (tail.size() > (1 << 16)) tail.erase(0, tail.size() - 4096);
+    }
+    close(out[0]);
+
+    int status;
+    struct rusage usage;
+    wait4(pid, &status, 0, &usage);
+    seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    peakRssKB = usage.ru_maxrss;
+    if (!WIFEXITED(status) || WEXITSTATUS(status) == 127) return -1;
+
+    size_t pos = tail.rfind("Tokens");
+    if (pos == string::npos) return -1;
+    pos = tail.find(':', pos);
+    return pos == string::npos ? -1 : atoll(tail.c_str() + pos + 1);
+}
+
+map<string, BenchResult> loadBaseline(const string& path) {
+    map<string, BenchResult> baseline;
+    ifstream in(path);
+    BenchResult r;
+    while (in >> r.name >> r.mbPerSec >> r.tokensPerSec >> r.peakRssKB) baseline[r.name] = r;
+    return baseline;
+}
+
+void saveBaseline(const string& path, const vector<BenchResult>& results) {
+    ofstream out(path);
+    for (auto& r : results)
+        out << r.name << " " << r.mbPerSec << " " << r.tokensPerSec << " " << r.peakRssKB << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    long long size = 16 << 20;
+    unsigned seed = 1;
+    int runs = 3;
+    double threshold = 10;
+    string binDir = ".", input, keep, saveTo, baselinePath;
+
+    for (int a = 1; a < argc; ++a) {
+        string arg = argv[a];
+        string value = a + 1 < argc ? argv[a + 1] : "";
+        // A missing or non-numeric value is a usage error, like an unknown option
+        try {
+            if (arg == "--size") size = parseSize(value);
+            else if (arg == "--seed") seed = stoul(value);
+            else if (arg == "--runs") runs = max(1, stoi(value));
+            else if (arg == "--threshold") threshold = stod(value);
+            else if (arg == "--bin-dir") binDir = value;
+            else if (arg == "--input") input = value;
+            else if (arg == "--keep") keep = value;
+            else if (arg == "--save-baseline") saveTo = value;
+            else if (arg == "--baseline") baselinePath = value;
+            else {
+                cerr << "Unknown option " << arg << "\n";
+                return 2;
+            }
+        } catch (const logic_error&) {
+            if (a + 1 == argc) cerr << "Missing value for " << arg << "\n";
+            else cerr << "Expected a number after " << arg << ", got '" << value << "'\n";
+            return 2;
+        }
+        if (++a == argc) {
+            cerr << "Missing value for " << arg << "\n";
+            return 2;
+        }
+    }
+
+    string path = input;
+    if (path.empty()) {
+        path = keep.empty() ? "/tmp/lexer_bench_" + to_string(getpid()) + ".c" : keep;
+        if (!generateSource(path, size, seed)) {
+            cerr << "Error: Could not write " << path << "\n";
+            return 1;
+        }
+    }
+    ifstream probe(path, ios::binary | ios::ate);
+    double megabytes = probe.tellg() / 1e6;
+
+    vector<pair<string, vector<string>>> lexers = {
+        {"lex_analyzer", {binDir + "/lex_analyzer", "--count", path}},
+        {"exp1", {binDir + "/exp1", path}},
+        {"exp2", {binDir + "/exp2", "--count", path}},
+    };
+
+    cout << "Input: " << path << " (" << fixed << setprecision(1) << megabytes << " MB), best of " << runs << "\n\n";
+    cout << left << setw(14) << "Lexer" << setw(12) << "MB/s" << setw(16) << "Tokens/s" << "Peak RSS (MB)\n";
+    cout << string(56, '-') << "\n";
+
+    vector<BenchResult> results;
+    vector<string> failed;
+    for (auto& lexer : lexers) {
+        BenchResult r;
+        r.name = lexer.first;
+        double best = 0;
+        long long tokens = -1;
+        for (int run = 0; run < runs; ++run) {
+            double seconds;
+            long rss;
+            tokens = runLexer(lexer.second, seconds, rss);
+            if (tokens < 0) break;
+            if (best == 0 || seconds < best) best = seconds;
+            r.peakRssKB = max(r.peakRssKB, rss);
+        }
+        if (tokens < 0) {
+            cout << setw(14) << r.name << "failed to run " << lexer.second[0] << "\n";
+            failed.push_back(r.name);
+            continue;
+        }
+        r.mbPerSec = megabytes / best;
+        r.tokensPerSec = tokens / best;
+        results.push_back(r);
+        cout << setw(14) << r.name << setw(12) << setprecision(1) << r.mbPerSec
+             << setw(16) << setprecision(0) << r.tokensPerSec << setprecision(1) << r.peakRssKB / 1024.0 << "\n";
+    }
+
+    if (input.empty() && keep.empty()) unlink(path.c_str());
+    if (!saveTo.empty()) saveBaseline(saveTo, results);
+
+    int regressions = 0;
+    if (!baselinePath.empty()) {
+        auto baseline = loadBaseline(baselinePath);
+        cout << "\nCompared with " << baselinePath << " (threshold " << setprecision(0) << threshold << "%):\n";
+        for (auto& r : results) {
+            auto it = baseline.find(r.name);
+            if (it == baseline.end()) continue;
+            double change = (r.mbPerSec / it->second.mbPerSec - 1) * 100;
+            bool regressed = change < -threshold;
+            regressions += regressed;
+            cout << "  " << setw(14) << r.name << showpos << setprecision(1) << change << noshowpos << "% MB/s"
+                 << (regressed ? "  REGRESSION" : "") << "\n";
+        }
+        // A lexer that crashed or printed no token count cannot pass the gate
+        for (auto& name : failed) {
+            if (!baseline.count(name)) continue;
+            ++regressions;
+            cout << "  " << setw(14) << name << "failed to run  REGRESSION\n";
+        }
+    }
+    return regressions ? 1 : 0;
+}
@@ -0,0 +1,84 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Read-only view of a whole input file. Regular files are memory-mapped so
+// lexers can hand out string_view tokens that point straight into the file;
+// anything that cannot be mapped (pipes, empty files) is read into a buffer.
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        opened = true;
+
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                madvise(p, st.st_size, MADV_SEQUENTIAL);
+                data = static_cast<const char*>(p);
+                size = st.st_size;
+                mapped = true;
+            }
+        }
+
+        if (!mapped) {
+            char chunk[1 << 16];
+            ssize_t got;
+            while ((got = ::read(fd, chunk, sizeof chunk)) > 0) buffer.append(chunk, got);
+            data = buffer.data();
+            size = buffer.size();
+        }
+        ::close(fd);
+    }
+
+    ~MappedFile() {
+        if (mapped) munmap(const_cast<char*>(data), size);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool is_open() const { return opened; }
+    std::string_view view() const { return std::string_view(data, size); }
+
+    // Lets the kernel drop the mapped pages before offset, for a reader that
+    // makes one pass. Views stay valid; touched again, a page is reread.
+    void releaseBefore(size_t offset) const {
+        if (!mapped) return;
+        size_t page = sysconf(_SC_PAGESIZE), end = std::min(offset, size) / page * page;
+        if (end) madvise(const_cast<char*>(data), end, MADV_DONTNEED);
+    }
+
+private:
+    const char* data = nullptr;
+    size_t size = 0;
+    bool opened = false;
+    bool mapped = false;
+    std::string buffer;
+};
+
+// Calls f(lineNo, line) for every line of text, numbering from firstLine.
+// Lines are split on '\n' exactly like getline, so a trailing newline does
+// not produce an extra empty line.
+template <typename F>
+void forEachLine(std::string_view text, F&& f, int firstLine = 1) {
+    int lineNo = firstLine - 1;
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string_view::npos) end = text.size();
+        f(++lineNo, text.substr(start, end - start));
+        start = end + 1;
+    }
+}
+
+#endif
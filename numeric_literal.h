@@ -0,0 +1,150 @@
+#ifndef NUMERIC_LITERAL_H
+#define NUMERIC_LITERAL_H
+
+#include <charconv>
+#include <cstddef>
+#include <string_view>
+
+// Single-pass scanner for C numeric literals:
+//   decimal 123, octal 0755, hex 0x1F, binary 0b101,
+//   floats 1.5, .5, 1., 1e10, 2.5E-3 and hex floats 0x1.8p3,
+//   integer suffixes u/U with l/L/ll/LL (either order), float suffixes f/F/l/L.
+// Integer values are accumulated while scanning. Float values are converted
+// with from_chars once the literal's extent is known.
+
+enum NumberKind { NUM_INVALID, NUM_INTEGER, NUM_FLOAT };
+
+struct NumericLiteral {
+    NumberKind kind = NUM_INVALID;
+    size_t end = 0;              // index just past the literal and its suffix
+    int base = 10;
+    bool isUnsigned = false;     // u/U suffix
+    int longCount = 0;           // number of l/L in the suffix
+    bool isFloatSuffix = false;  // f/F suffix
+    bool overflow = false;       // integer value does not fit in 64 bits
+    unsigned long long intValue = 0;
+    double floatValue = 0;
+};
+
+namespace numeric_literal {
+
+inline int digitValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if ((c | 0x20) >= 'a' && (c | 0x20) <= 'f') return (c | 0x20) - 'a' + 10;
+    return 99;
+}
+
+inline bool isDecimal(char c) { return c >= '0' && c <= '9'; }
+
+// Index past an exponent at i ([eEpP][+-]?[0-9]+), or i if there is none.
+inline size_t skipExponent(std::string_view s, size_t i, char marker) {
+    if (i >= s.size() || (s[i] | 0x20) != marker) return i;
+    size_t j = i + 1;
+    if (j < s.size() && (s[j] == '+' || s[j] == '-')) ++j;
+    if (j >= s.size() || !isDecimal(s[j])) return i;
+    while (j < s.size() && isDecimal(s[j])) ++j;
+    return j;
+}
+
+} // namespace numeric_literal
+
+inline bool startsNumber(std::string_view s, size_t i) {
+    using numeric_literal::isDecimal;
+    return i < s.size() && (isDecimal(s[i]) || (s[i] == '.' && i + 1 < s.size() && isDecimal(s[i + 1])));
+}
+
+// Scans the literal starting at s[i]. The literal ends at the first character
+// that cannot continue it; callers decide whether a following letter or digit
+// makes the whole word invalid. kind is NUM_INVALID if no literal starts at i
+// or its digits are wrong for its base (09, 0x, 0b2).
+inline NumericLiteral scanNumber(std::string_view s, size_t i) {
+    using namespace numeric_literal;
+    NumericLiteral num;
+    const size_t n = s.size();
+    num.end = i;
+    if (!startsNumber(s, i)) return num;
+
+    size_t start = i;
+    bool isFloat = false, badDigit = false;
+
+    if (s[i] == '0' && i + 1 < n && ((s[i + 1] | 0x20) == 'x' || (s[i + 1] | 0x20) == 'b')) {
+        num.base = (s[i + 1] | 0x20) == 'x' ? 16 : 2;
+        i += 2;
+        size_t digits = i;
+        while (i < n && digitValue(s[i]) < num.base) {
+            unsigned long long next;
+            if (__builtin_mul_overflow(num.intValue, (unsigned)num.base, &next) ||
+                __builtin_add_overflow(next, (unsigned)digitValue(s[i]), &num.intValue))
+                num.overflow = true;
+            ++i;
+        }
+        bool anyDigits = i > digits;
+
+        // Hex float: fraction optional, binary exponent required
+        if (num.base == 16 && i < n && (s[i] == '.' || (s[i] | 0x20) == 'p')) {
+            size_t j = i;
+            if (s[j] == '.')
+                for (++j; j < n && digitValue(s[j]) < 16; ++j) anyDigits = true;
+            size_t expEnd = skipExponent(s, j, 'p');
+            if (anyDigits && expEnd > j) {
+                i = expEnd;
+                isFloat = true;
+            }
+        }
+        if (!anyDigits) {
+            num.end = i;
+            return num;
+        }
+    } else {
+        // Decimal or octal mantissa
+        bool leadingZero = s[i] == '0';
+        while (i < n && isDecimal(s[i])) {
+            int d = s[i] - '0';
+            if (leadingZero && d >= 8) badDigit = true;
+            unsigned long long next;
+            unsigned base = leadingZero ? 8 : 10;
+            if (__builtin_mul_overflow(num.intValue, base, &next) || __builtin_add_overflow(next, (unsigned)d, &num.intValue))
+                num.overflow = true;
+            ++i;
+        }
+        if (i < n && s[i] == '.') {
+            isFloat = true;
+            for (++i; i < n && isDecimal(s[i]);) ++i;
+        }
+        size_t expEnd = skipExponent(s, i, 'e');
+        isFloat |= expEnd > i;
+        i = expEnd;
+        if (leadingZero && !isFloat) num.base = 8;
+    }
+
+    size_t literalEnd = i;
+    if (isFloat) {
+        if (i < n && ((s[i] | 0x20) == 'f' || (s[i] | 0x20) == 'l')) {
+            num.isFloatSuffix = (s[i] | 0x20) == 'f';
+            num.longCount = (s[i] | 0x20) == 'l';
+            ++i;
+        }
+        const char* first = s.data() + start + (num.base == 16 ? 2 : 0);
+        std::from_chars(first, s.data() + literalEnd, num.floatValue,
+                        num.base == 16 ? std::chars_format::hex : std::chars_format::general);
+        num.kind = NUM_FLOAT;
+        num.end = i;
+        return num;
+    }
+
+    // Integer suffix: u and l/ll in either order; ll must not mix cases
+    for (int part = 0; part < 2 && i < n; ++part) {
+        if (!num.isUnsigned && (s[i] | 0x20) == 'u') {
+            num.isUnsigned = true;
+            ++i;
+        } else if (num.longCount == 0 && (s[i] | 0x20) == 'l') {
+            num.longCount = i + 1 < n && s[i + 1] == s[i] ? 2 : 1;
+            i += num.longCount;
+        }
+    }
+    num.kind = badDigit ? NUM_INVALID : NUM_INTEGER;
+    num.end = i;
+    return num;
+}
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef PARALLEL_LEX_H
+#define PARALLEL_LEX_H
+
+#include <algorithm>
+#include <atomic>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "comment_scan.h"
+#include "mapped_file.h"
+
+// Splits a source into line-aligned chunks that are lexed on worker threads.
+//
+// The only state a lexer carries from one line to the next is whether it is
+// inside a /* */ comment (string literals end with their line). Each worker
+// guesses that state for its chunk, lexes, and reports the state at its
+// end. A sequential fix-up pass then walks the chunks in order with the
+// real state, and only the chunks that guessed wrong are lexed again.
+
+struct SourceChunk {
+    std::string_view text;
+    int firstLine;
+};
+
+// Same comment rules as the lexers (see comment_scan.h).
+inline bool commentStateAfter(std::string_view text, bool inComment) {
+    return forEachCodeSpan(text, [](int, std::string_view) {}, 1, inComment);
+}
+
+// A chunk probably starts inside a comment if a "*/" shows up before any "/*".
+inline bool guessStartsInComment(std::string_view text) {
+    std::string_view head = text.substr(0, 1 << 16);
+    size_t close = head.find("*/");
+    return close != std::string_view::npos && close < head.find("/*");
+}
+
+inline std::vector<SourceChunk> splitIntoChunks(std::string_view source, size_t count) {
+    std::vector<SourceChunk> chunks;
+    size_t target = std::max<size_t>(source.size() / std::max<size_t>(count, 1), 1);
+    size_t start = 0;
+    int line = 1;
+    while (start < source.size()) {
+        size_t end = std::min(start + target, source.size());
+        if (end < source.size()) {
+            end = source.find('\n', end - 1);
+            end = end == std::string_view::npos ? source.size() : end + 1;
+        }
+        std::string_view text = source.substr(start, end - start);
+        chunks.push_back({text, line});
+        line += std::count(text.begin(), text.end(), '\n');
+        start = end;
+    }
+    return chunks;
+}
+
+// Runs job(0) .. job(count - 1) on up to `threads` threads.
+template <typename Job>
+void runOnWorkers(size_t count, int threads, Job&& job) {
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t i; (i = next++) < count;) job(i);
+    };
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads && (size_t)t < count; ++t) pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool) th.join();
+}
+
+// Lexes source in chunks on `threads` threads and returns one Result per
+// chunk, in source order. lexChunk(chunk, startsInComment, result) must lex
+// the chunk into result and return whether it ends inside a comment.
+template <typename Result, typename LexChunk>
+std::vector<Result> lexInParallel(std::string_view source, int threads, LexChunk&& lexChunk) {
+    const size_t minChunk = 1 << 16;
+    size_t count = std::min<size_t>(threads * 4, source.size() / minChunk + 1);
+    std::vector<SourceChunk> chunks = splitIntoChunks(source, count);
+    std::vector<Result> results(chunks.size());
+    std::vector<char> guess(chunks.size()), endState(chunks.size());
+
+    runOnWorkers(chunks.size(), threads, [&](size_t c) {
+        guess[c] = c > 0 && guessStartsInComment(chunks[c].text);
+        endState[c] = lexChunk(chunks[c], guess[c], results[c]);
+    });
+
+    // Fix-up: find the real start state of every chunk
+    std::vector<size_t> redo;
+    std::vector<char> realStart(chunks.size());
+    bool state = false;
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        realStart[c] = state;
+        if (state == guess[c]) {
+            state = endState[c];
+        } else {
+            redo.push_back(c);
+            state = commentStateAfter(chunks[c].text, state);
+        }
+    }
+
+    runOnWorkers(redo.size(), threads, [&](size_t r) {
+        size_t c = redo[r];
+        results[c] = Result();
+        lexChunk(chunks[c], realStart[c], results[c]);
+    });
+    return results;
+}
+
+#endif
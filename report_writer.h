@@ -0,0 +1,144 @@
+#ifndef REPORT_WRITER_H
+#define REPORT_WRITER_H
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+#include "utf8.h"
+
+// Formats report output into one reusable buffer and hands it to the kernel
+// with write() only when the buffer fills or the writer is flushed, so a
+// typical report costs a single system call and no per-row streams.
+
+enum ReportFormat { REPORT_TEXT, REPORT_CSV, REPORT_JSONL };
+
+inline bool parseReportFormat(std::string_view name, ReportFormat& format) {
+    if (name == "text") format = REPORT_TEXT;
+    else if (name == "csv") format = REPORT_CSV;
+    else if (name == "jsonl") format = REPORT_JSONL;
+    else return false;
+    return true;
+}
+
+// Columns a string takes up: UTF-8 continuation bytes do not count.
+inline size_t textWidth(std::string_view s) {
+    size_t width = 0;
+    for (unsigned char c : s) width += (c & 0xC0) != 0x80;
+    return width;
+}
+
+class ReportWriter {
+public:
+    explicit ReportWriter(int fd = STDOUT_FILENO, size_t capacity = 1 << 20) : fd(fd), capacity(capacity) {
+        buffer.reserve(capacity);
+    }
+
+    ~ReportWriter() { flush(); }
+
+    ReportWriter(const ReportWriter&) = delete;
+    ReportWriter& operator=(const ReportWriter&) = delete;
+
+    ReportWriter& put(char c) {
+        if (buffer.size() >= capacity) flush();
+        buffer.push_back(c);
+        return *this;
+    }
+
+    ReportWriter& text(std::string_view s) {
+        if (buffer.size() + s.size() > capacity) flush();
+        buffer.append(s);
+        return *this;
+    }
+
+    ReportWriter& number(long long n) {
+        char digits[24];
+        return text(formatNumber(digits, n));
+    }
+
+    ReportWriter& spaces(size_t n) {
+        while (n > 0) {
+            if (buffer.size() >= capacity) flush();
+            size_t step = std::min(n, capacity - buffer.size());
+            buffer.append(step, ' ');
+            n -= step;
+        }
+        return *this;
+    }
+
+    // Left-aligned in a field of width characters, like `left << setw(width)`
+    // but counting UTF-8 characters rather than bytes.
+    ReportWriter& padded(std::string_view s, size_t width) {
+        text(s);
+        size_t used = textWidth(s);
+        return spaces(width > used ? width - used : 0);
+    }
+
+    ReportWriter& padded(long long n, size_t width) {
+        char digits[24];
+        return padded(formatNumber(digits, n), width);
+    }
+
+    // RFC 4180 field: quoted only when it contains a comma, quote or newline.
+    ReportWriter& csvField(std::string_view s) {
+        bool quote = false;
+        for (char c : s) quote |= c == ',' || c == '"' || c == '\r' || c == '\n';
+        if (!quote) return text(s);
+        put('"');
+        for (char c : s) {
+            if (c == '"') put('"');
+            put(c);
+        }
+        return put('"');
+    }
+
+    // Quoted JSON string. Valid UTF-8 is copied through; each byte that is
+    // not part of a valid sequence becomes \ufffd, so the line stays valid JSON.
+    ReportWriter& jsonString(std::string_view s) {
+        static const char hex[] = "0123456789abcdef";
+        put('"');
+        uint32_t cp;
+        for (size_t i = 0; i < s.size(); ++i) {
+            unsigned char c = s[i];
+            if (c >= 0x80) {
+                size_t len = decodeUtf8(s, i, cp);
+                if (len == 0) {
+                    text("\\ufffd");
+                } else {
+                    text(s.substr(i, len));
+                    i += len - 1;
+                }
+            } else if (c == '"' || c == '\\') put('\\').put(c);
+            else if (c == '\n') text("\\n");
+            else if (c == '\r') text("\\r");
+            else if (c == '\t') text("\\t");
+            else if (c < 0x20) text("\\u00").put(hex[c >> 4]).put(hex[c & 15]);
+            else put(c);
+        }
+        return put('"');
+    }
+
+    void flush() {
+        size_t done = 0;
+        while (done < buffer.size()) {
+            ssize_t n = ::write(fd, buffer.data() + done, buffer.size() - done);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break;
+            done += n;
+        }
+        buffer.clear();
+    }
+
+private:
+    int fd;
+    size_t capacity;
+    std::string buffer;
+
+    static std::string_view formatNumber(char (&digits)[24], long long n) {
+        return std::string_view(digits, std::to_chars(digits, digits + sizeof digits, n).ptr - digits);
+    }
+};
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef SOURCE_FILES_H
+#define SOURCE_FILES_H
+
+#include <algorithm>
+#include <filesystem>
+#include <set>
+#include <string>
+#include <vector>
+
+// Expands directories (recursively) into their C/C++ sources and returns the
+// sorted list of files, so batch output does not depend on directory order.
+inline std::vector<std::string> collectSourceFiles(const std::vector<std::string>& paths) {
+    static const std::set<std::string> extensions = {".c", ".cc", ".cpp", ".cxx", ".h", ".hh", ".hpp"};
+    std::vector<std::string> files;
+    for (const std::string& path : paths) {
+        std::error_code ec;
+        if (std::filesystem::is_directory(path, ec)) {
+            for (auto& entry : std::filesystem::recursive_directory_iterator(path, ec))
+                if (entry.is_regular_file() && extensions.count(entry.path().extension().string()))
+                    files.push_back(entry.path().string());
+        } else {
+            files.push_back(path);
+        }
+    }
+    std::sort(files.begin(), files.end());
+    files.erase(std::unique(files.begin(), files.end()), files.end());
+    return files;
+}
+
+#endif
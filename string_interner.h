@@ -0,0 +1,95 @@
+#ifndef STRING_INTERNER_H
+#define STRING_INTERNER_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Maps each distinct lexeme to a dense 32-bit ID (0, 1, 2, ...). All lexeme
+// bytes live back to back in one arena, and lookups go through an
+// open-addressing hash table of IDs, so interning a known lexeme is one hash
+// and (usually) one comparison, with no allocation.
+class StringInterner {
+public:
+    static constexpr uint32_t NOT_FOUND = UINT32_MAX;
+
+    StringInterner() : slots(16, EMPTY) { starts.push_back(0); }
+
+    // Returns the ID of s, adding it if needed; inserted tells which happened.
+    uint32_t intern(std::string_view s, bool& inserted) {
+        uint32_t h = hashOf(s);
+        size_t slot = probe(s, h);
+        inserted = slots[slot] == EMPTY;
+        if (!inserted) return slots[slot];
+
+        uint32_t id = size();
+        arena.append(s.data(), s.size());
+        starts.push_back(arena.size());
+        hashes.push_back(h);
+        slots[slot] = id;
+        if ((size_t)size() * 4 > slots.size() * 3) grow();
+        return id;
+    }
+
+    uint32_t intern(std::string_view s) {
+        bool inserted;
+        return intern(s, inserted);
+    }
+
+    uint32_t find(std::string_view s) const {
+        return slots[probe(s, hashOf(s))];
+    }
+
+    std::string_view lexeme(uint32_t id) const {
+        return std::string_view(arena.data() + starts[id], starts[id + 1] - starts[id]);
+    }
+
+    uint32_t size() const { return hashes.size(); }
+
+    // Bytes reserved by the arena, offsets and hash table.
+    size_t memoryUsage() const {
+        return arena.capacity() + starts.capacity() * sizeof(uint32_t) +
+               hashes.capacity() * sizeof(uint32_t) + slots.capacity() * sizeof(uint32_t);
+    }
+
+    // FNV-1a, folded to 32 bits.
+    static uint32_t hashOf(std::string_view s) {
+        uint64_t h = 14695981039346656037ull;
+        for (unsigned char c : s) {
+            h ^= c;
+            h *= 1099511628211ull;
+        }
+        return (uint32_t)(h ^ (h >> 32));
+    }
+
+private:
+    static constexpr uint32_t EMPTY = NOT_FOUND;
+
+    std::string arena;            // lexeme bytes, in ID order
+    std::vector<uint32_t> starts; // starts[id]..starts[id + 1] is lexeme id
+    std::vector<uint32_t> hashes; // hash of each lexeme, reused when growing
+    std::vector<uint32_t> slots;  // power-of-two table of IDs
+
+    // Slot holding s, or the empty slot where it would go.
+    size_t probe(std::string_view s, uint32_t h) const {
+        size_t mask = slots.size() - 1;
+        for (size_t i = h & mask;; i = (i + 1) & mask) {
+            uint32_t id = slots[i];
+            if (id == EMPTY || (hashes[id] == h && lexeme(id) == s)) return i;
+        }
+    }
+
+    void grow() {
+        std::vector<uint32_t> bigger(slots.size() * 2, EMPTY);
+        size_t mask = bigger.size() - 1;
+        for (uint32_t id = 0; id < size(); ++id) {
+            size_t i = hashes[id] & mask;
+            while (bigger[i] != EMPTY) i = (i + 1) & mask;
+            bigger[i] = id;
+        }
+        slots.swap(bigger);
+    }
+};
+
+#endif
@@ -17,6 +17,9 @@ int main() {
         std::cout << "B is less or equal to A" << std::endl;
     }
 
+    // An escaped quote and a // inside a string stay in the literal
+    char* s = "a\"b // not comment";
+
     return 0;
 }
 
@@ -1,5 +1,6 @@
 
 #include <bits/stdc++.h>
+#include "utf8.h"
 using namespace std;
 
 struct Quadruple {
@@ -40,20 +41,12 @@ void printTriples(const vector<Triple>& triples) {
 }
 
 // ---------------- Tokenizer ----------------
-static inline bool isIdentChar(char c) {
-    return isalnum((unsigned char)c) || c == '_';
-}
-
-vector<string> tokenize(const string &s_in) {
-    string s = s_in;
-    // replace unicode ≠ with "!=" if present
-    for (size_t p = 0; p + 2 <= s.size(); ++p) {
-        if ((unsigned char)s[p] == 0xC2 || (unsigned char)s[p] == 0xE2) { /*skip - crude*/ }
-    }
-    // quick replace common unicode '≠' (U+2260) with "!="
-    size_t pos;
-    while ((pos = s.find("≠")) != string::npos) s.replace(pos, 3, "!=");
+// Unicode comparison operators accepted as spellings of the ASCII ones
+static const pair<const char*, const char*> unicodeOperators[] = {
+    {"≠", "!="}, {"≤", "<="}, {"≥", ">="}
+};
 
+vector<string> tokenize(const string &s) {
     vector<string> toks;
     for (size_t i = 0; i < s.size();) {
         if (isspace((unsigned char)s[i])) { ++i; continue; }
@@ -67,6 +60,19 @@ vector<string> tokenize(const string &s_in) {
         if (c == '<' && i + 1 < s.size() && s[i+1] == '=') { toks.push_back("<="); i += 2; continue; }
         if (c == '>' && i + 1 < s.size() && s[i+1] == '=') { toks.push_back(">="); i += 2; continue; }
 
+        if ((unsigned char)c >= 0x80) {
+            bool matched = false;
+            for (auto &op : unicodeOperators) {
+                if (s.compare(i, strlen(op.first), op.first) == 0) {
+                    toks.push_back(op.second);
+                    i += strlen(op.first);
+                    matched = true;
+                    break;
+                }
+            }
+            if (matched) continue;
+        }
+
         // single-char tokens
         if (strchr("()+-*/<>{};:,", c)) {
             toks.push_back(string(1, c));
@@ -74,9 +80,13 @@ vector<string> tokenize(const string &s_in) {
             continue;
         }
 
-        if (isalpha((unsigned char)c)) {
-            string id;
-            while (i < s.size() && isIdentChar(s[i])) { id.push_back(s[i]); ++i; }
+        // identifiers, including non-ASCII ones (XID_Start XID_Continue*).
+        // A leading '_' starts an identifier too, as in C, so "_t1" is one
+        // token rather than "_" followed by "t1".
+        if (size_t len = identStartLength(s, i)) {
+            size_t start = i;
+            for (i += len; i < s.size() && (len = identContinueLength(s, i)); i += len) {}
+            string id = s.substr(start, i - start);
             // keywords mapping
             string low = id;
             for (auto &ch : low) ch = (char)tolower((unsigned char)ch);
@@ -97,9 +107,10 @@ vector<string> tokenize(const string &s_in) {
             continue;
         }
 
-        // fallback single char token
-        toks.push_back(string(1, c));
-        ++i;
+        // fallback single char token (a whole UTF-8 sequence)
+        size_t len = charLength(s, i);
+        toks.push_back(s.substr(i, len));
+        i += len;
     }
     return toks;
 }
@@ -494,6 +505,7 @@ int main() {
     string arith = "(A + B) * (C - D) / (E + F)";
     string booleanIf = "if((a < b) and (c != d)) then x = 1 else x = 0";
     string whl = "while (i < n) { sum = sum + i; i = i + 1; }";
+    string idents = "(_base + rate) * _scale_2";
 
     // ---------- Test Case 1: Arithmetic ----------
     cout << "\n******** Test Case 1: Arithmetic Expression ********\n";
@@ -540,6 +552,21 @@ int main() {
     printQuadruples(quads3);
     printTriples(triples3);
 
+    // ---------- Test Case 4: Identifiers starting with '_' ----------
+    cout << "\n******** Test Case 4: Underscore Identifiers ********\n";
+    cout << "Expression: " << idents << "\n";
+    vector<Quadruple> quads4;
+    vector<Triple> triples4;
+    vector<string> eqs4;
+    int tcount4 = 1;
+    processArithmeticExpression(idents, quads4, triples4, eqs4, tcount4);
+    if (!eqs4.empty()) {
+        cout << "\nStep-by-step equations:\n";
+        for (auto &e : eqs4) cout << e << "\n";
+    }
+    printQuadruples(quads4);
+    printTriples(triples4);
+
     cout << "\n";
     return 0;
 }
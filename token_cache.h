@@ -0,0 +1,193 @@
+#ifndef TOKEN_CACHE_H
+#define TOKEN_CACHE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unistd.h>
+#include "mapped_file.h"
+#include "string_interner.h"
+
+// Binary token stream cache. A lexer records every token once, and later
+// runs (or later stages) map the file back instead of lexing the source
+// again. Cache files are named after a hash of the source contents, so an
+// edited file simply misses.
+//
+// Layout (native endianness):
+//   TokenCacheHeader
+//   CachedToken[tokenCount]
+//   uint32_t symbolStarts[symbolCount + 1]   offsets into the symbol bytes
+//   char symbolBytes[]                       interned lexemes, back to back
+
+// The last three are markers written by include-aware lexing: an #include
+// (lexeme "name" or <name>), the file's include guard macro, and #pragma once.
+enum CachedKind : uint8_t {
+    CK_SPECIAL_SYMBOL, CK_OPERATOR, CK_KEYWORD, CK_INTEGER, CK_FLOAT, CK_IDENTIFIER, CK_LITERAL, CK_ERROR,
+    CK_INCLUDE, CK_GUARD, CK_PRAGMA_ONCE
+};
+
+struct CachedToken {
+    uint32_t offset;           // byte offset of the lexeme in the source
+    uint32_t symbol;           // interned lexeme ID
+    uint32_t kindAndLineDelta; // kind in bits 0-7, lines since the previous token in 8-31
+
+    CachedKind kind() const { return (CachedKind)(kindAndLineDelta & 0xFF); }
+    uint32_t lineDelta() const { return kindAndLineDelta >> 8; }
+};
+
+struct TokenCacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t contentHash;
+    uint64_t sourceSize;
+    uint64_t tokenCount;
+    uint32_t symbolCount;
+    uint32_t symbolBytes;
+};
+
+namespace token_cache {
+
+constexpr char MAGIC[4] = {'T', 'O', 'K', 'C'};
+constexpr uint32_t VERSION = 3;
+constexpr uint32_t MAX_LINE_DELTA = (1u << 24) - 1;
+
+} // namespace token_cache
+
+// 64-bit hash of a whole source file, eight bytes per step.
+inline uint64_t contentHash(std::string_view s) {
+    uint64_t h = 14695981039346656037ull ^ s.size();
+    size_t i = 0;
+    for (; i + 8 <= s.size(); i += 8) {
+        uint64_t w;
+        std::memcpy(&w, s.data() + i, 8);
+        h = (h ^ w) * 0x9E3779B97F4A7C15ull;
+        h ^= h >> 29;
+    }
+    for (; i < s.size(); ++i) h = (h ^ (unsigned char)s[i]) * 1099511628211ull;
+    return h ^ (h >> 32);
+}
+
+// Path of the cache entry for a source with the given hash.
+inline std::string tokenCachePath(const std::string& dir, uint64_t hash) {
+    char name[32];
+    std::snprintf(name, sizeof name, "/%016llx.tok", (unsigned long long)hash);
+    return dir + name;
+}
+
+// Collects tokens while lexing and writes them out as a cache file.
+class TokenCacheWriter {
+public:
+    explicit TokenCacheWriter(std::string_view source) : source(source) {}
+
+    // lexeme must be a view into the source passed to the constructor.
+    void add(CachedKind kind, std::string_view lexeme, int line) {
+        uint32_t delta = line - lastLine;
+        if (delta > token_cache::MAX_LINE_DELTA) overflow = true;
+        lastLine = line;
+        tokens.push_back({(uint32_t)(lexeme.data() - source.data()), names.intern(lexeme),
+                          (delta << 8) | kind});
+    }
+
+    // Writes to a temporary file and renames it into place, so readers never
+    // see a half-written entry. Returns false if nothing was written.
+    bool save(const std::string& path, uint64_t hash) const {
+        if (overflow || source.size() > UINT32_MAX) return false;
+
+        TokenCacheHeader header = {};
+        std::memcpy(header.magic, token_cache::MAGIC, 4);
+        header.version = token_cache::VERSION;
+        header.contentHash = hash;
+        header.sourceSize = source.size();
+        header.tokenCount = tokens.size();
+        header.symbolCount = names.size();
+
+        std::vector<uint32_t> starts(names.size() + 1, 0);
+        std::string bytes;
+        for (uint32_t id = 0; id < names.size(); ++id) {
+            bytes += names.lexeme(id);
+            starts[id + 1] = bytes.size();
+        }
+        header.symbolBytes = bytes.size();
+
+        std::string tmp = path + ".tmp" + std::to_string(getpid());
+        FILE* out = std::fopen(tmp.c_str(), "wb");
+        if (!out) return false;
+        bool ok = std::fwrite(&header, sizeof header, 1, out) == 1 &&
+                  std::fwrite(tokens.data(), sizeof(CachedToken), tokens.size(), out) == tokens.size() &&
+                  std::fwrite(starts.data(), sizeof(uint32_t), starts.size(), out) == starts.size() &&
+                  std::fwrite(bytes.data(), 1, bytes.size(), out) == bytes.size();
+        ok = std::fclose(out) == 0 && ok;
+        if (ok && std::rename(tmp.c_str(), path.c_str()) == 0) return true;
+        std::remove(tmp.c_str());
+        return false;
+    }
+
+private:
+    std::string_view source;
+    StringInterner names;
+    std::vector<CachedToken> tokens;
+    int lastLine = 1;
+    bool overflow = false;
+};
+
+// Maps a cache file and exposes its tokens and symbols without copying.
+class TokenCache {
+public:
+    // Opens the entry at path; valid() is false if it is missing, truncated,
+    // corrupt or belongs to different source contents. Every symbol offset
+    // and token is checked here, so the accessors need no bounds checks.
+    TokenCache(const std::string& path, uint64_t hash, size_t sourceSize) : file(path) {
+        std::string_view data = file.view();
+        if (!file.is_open() || data.size() < sizeof(TokenCacheHeader)) return;
+        std::memcpy(&header, data.data(), sizeof header);
+        if (std::memcmp(header.magic, token_cache::MAGIC, 4) != 0 || header.version != token_cache::VERSION ||
+            header.contentHash != hash || header.sourceSize != sourceSize)
+            return;
+
+        size_t payload = data.size() - sizeof header;
+        if (header.tokenCount > payload / sizeof(CachedToken)) return;
+        size_t tokenBytes = header.tokenCount * sizeof(CachedToken);
+        size_t startBytes = (header.symbolCount + 1ull) * sizeof(uint32_t);
+        if (payload != tokenBytes + startBytes + header.symbolBytes) return;
+
+        tokenData = reinterpret_cast<const CachedToken*>(data.data() + sizeof header);
+        starts = reinterpret_cast<const uint32_t*>(data.data() + sizeof header + tokenBytes);
+        symbolBytes = data.data() + sizeof header + tokenBytes + startBytes;
+
+        // Symbol offsets rise from 0 to the end of the symbol bytes
+        if (starts[0] != 0 || starts[header.symbolCount] != header.symbolBytes) return;
+        for (uint32_t id = 0; id < header.symbolCount; ++id)
+            if (starts[id + 1] < starts[id]) return;
+        // Tokens have a known kind, name an existing symbol and lie within
+        // the source
+        for (const CachedToken& t : *this) {
+            if (t.symbol >= header.symbolCount || t.kind() > CK_PRAGMA_ONCE) return;
+            if (t.offset > sourceSize || starts[t.symbol + 1] - starts[t.symbol] > sourceSize - t.offset) return;
+        }
+        ok = true;
+    }
+
+    bool valid() const { return ok; }
+    size_t size() const { return header.tokenCount; }
+    const CachedToken& operator[](size_t i) const { return tokenData[i]; }
+    const CachedToken* begin() const { return tokenData; }
+    const CachedToken* end() const { return tokenData + header.tokenCount; }
+
+    uint32_t symbolCount() const { return header.symbolCount; }
+    std::string_view lexeme(uint32_t id) const {
+        return std::string_view(symbolBytes + starts[id], starts[id + 1] - starts[id]);
+    }
+
+private:
+    MappedFile file;
+    TokenCacheHeader header = {};
+    const CachedToken* tokenData = nullptr;
+    const uint32_t* starts = nullptr;
+    const char* symbolBytes = nullptr;
+    bool ok = false;
+};
+
+#endif
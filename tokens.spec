@@ -0,0 +1,12 @@
+// Token spec for dfa --spec, with the token kinds of lex_analyzer.cpp.
+// NAME PRIORITY REGEX, one per line. The longest match wins, then the
+// higher priority, then the earlier line. "skip" tokens are not reported.
+skip        0  [ \t\r\n]+
+skip        0  //[^\n]*
+skip        0  /\*([^*]|\*+[^*/])*\*+/
+keyword     2  int|float|char|double|void|bool|string|if|else|while|for|return
+identifier  1  [a-zA-Z_][a-zA-Z0-9_]*
+integer     1  [0-9]+
+float       1  [0-9]*\.[0-9]+
+literal     1  "[^"\n]*"
+operator    1  [=+\-*/{}();,><']
@@ -0,0 +1,375 @@
+#ifndef UNICODE_XID_H
+#define UNICODE_XID_H
+
+#include <cstdint>
+
+// XID_Start and XID_Continue for code points >= 0x80, Unicode 14.0.0
+// (DerivedCoreProperties.txt). Each table lists the code points where
+// membership flips, starting outside: cp is in the set when an odd number
+// of entries are <= cp.
+
+namespace unicode_xid {
+
+inline constexpr uint32_t startBounds[] = {
+    0x000AA, 0x000AB, 0x000B5, 0x000B6, 0x000BA, 0x000BB, 0x000C0, 0x000D7,
+    0x000D8, 0x000F7, 0x000F8, 0x002C2, 0x002C6, 0x002D2, 0x002E0, 0x002E5,
+    0x002EC, 0x002ED, 0x002EE, 0x002EF, 0x00370, 0x00375, 0x00376, 0x00378,
+    0x0037B, 0x0037E, 0x0037F, 0x00380, 0x00386, 0x00387, 0x00388, 0x0038B,
+    0x0038C, 0x0038D, 0x0038E, 0x003A2, 0x003A3, 0x003F6, 0x003F7, 0x00482,
+    0x0048A, 0x00530, 0x00531, 0x00557, 0x00559, 0x0055A, 0x00560, 0x00589,
+    0x005D0, 0x005EB, 0x005EF, 0x005F3, 0x00620, 0x0064B, 0x0066E, 0x00670,
+    0x00671, 0x006D4, 0x006D5, 0x006D6, 0x006E5, 0x006E7, 0x006EE, 0x006F0,
+    0x006FA, 0x006FD, 0x006FF, 0x00700, 0x00710, 0x00711, 0x00712, 0x00730,
+    0x0074D, 0x007A6, 0x007B1, 0x007B2, 0x007CA, 0x007EB, 0x007F4, 0x007F6,
+    0x007FA, 0x007FB, 0x00800, 0x00816, 0x0081A, 0x0081B, 0x00824, 0x00825,
+    0x00828, 0x00829, 0x00840, 0x00859, 0x00860, 0x0086B, 0x00870, 0x00888,
+    0x00889, 0x0088F, 0x008A0, 0x008CA, 0x00904, 0x0093A, 0x0093D, 0x0093E,
+    0x00950, 0x00951, 0x00958, 0x00962, 0x00971, 0x00981, 0x00985, 0x0098D,
+    0x0098F, 0x00991, 0x00993, 0x009A9, 0x009AA, 0x009B1, 0x009B2, 0x009B3,
+    0x009B6, 0x009BA, 0x009BD, 0x009BE, 0x009CE, 0x009CF, 0x009DC, 0x009DE,
+    0x009DF, 0x009E2, 0x009F0, 0x009F2, 0x009FC, 0x009FD, 0x00A05, 0x00A0B,
+    0x00A0F, 0x00A11, 0x00A13, 0x00A29, 0x00A2A, 0x00A31, 0x00A32, 0x00A34,
+    0x00A35, 0x00A37, 0x00A38, 0x00A3A, 0x00A59, 0x00A5D, 0x00A5E, 0x00A5F,
+    0x00A72, 0x00A75, 0x00A85, 0x00A8E, 0x00A8F, 0x00A92, 0x00A93, 0x00AA9,
+    0x00AAA, 0x00AB1, 0x00AB2, 0x00AB4, 0x00AB5, 0x00ABA, 0x00ABD, 0x00ABE,
+    0x00AD0, 0x00AD1, 0x00AE0, 0x00AE2, 0x00AF9, 0x00AFA, 0x00B05, 0x00B0D,
+    0x00B0F, 0x00B11, 0x00B13, 0x00B29, 0x00B2A, 0x00B31, 0x00B32, 0x00B34,
+    0x00B35, 0x00B3A, 0x00B3D, 0x00B3E, 0x00B5C, 0x00B5E, 0x00B5F, 0x00B62,
+    0x00B71, 0x00B72, 0x00B83, 0x00B84, 0x00B85, 0x00B8B, 0x00B8E, 0x00B91,
+    0x00B92, 0x00B96, 0x00B99, 0x00B9B, 0x00B9C, 0x00B9D, 0x00B9E, 0x00BA0,
+    0x00BA3, 0x00BA5, 0x00BA8, 0x00BAB, 0x00BAE, 0x00BBA, 0x00BD0, 0x00BD1,
+    0x00C05, 0x00C0D, 0x00C0E, 0x00C11, 0x00C12, 0x00C29, 0x00C2A, 0x00C3A,
+    0x00C3D, 0x00C3E, 0x00C58, 0x00C5B, 0x00C5D, 0x00C5E, 0x00C60, 0x00C62,
+    0x00C80, 0x00C81, 0x00C85, 0x00C8D, 0x00C8E, 0x00C91, 0x00C92, 0x00CA9,
+    0x00CAA, 0x00CB4, 0x00CB5, 0x00CBA, 0x00CBD, 0x00CBE, 0x00CDD, 0x00CDF,
+    0x00CE0, 0x00CE2, 0x00CF1, 0x00CF3, 0x00D04, 0x00D0D, 0x00D0E, 0x00D11,
+    0x00D12, 0x00D3B, 0x00D3D, 0x00D3E, 0x00D4E, 0x00D4F, 0x00D54, 0x00D57,
+    0x00D5F, 0x00D62, 0x00D7A, 0x00D80, 0x00D85, 0x00D97, 0x00D9A, 0x00DB2,
+    0x00DB3, 0x00DBC, 0x00DBD, 0x00DBE, 0x00DC0, 0x00DC7, 0x00E01, 0x00E31,
+    0x00E32, 0x00E33, 0x00E40, 0x00E47, 0x00E81, 0x00E83, 0x00E84, 0x00E85,
+    0x00E86, 0x00E8B, 0x00E8C, 0x00EA4, 0x00EA5, 0x00EA6, 0x00EA7, 0x00EB1,
+    0x00EB2, 0x00EB3, 0x00EBD, 0x00EBE, 0x00EC0, 0x00EC5, 0x00EC6, 0x00EC7,
+    0x00EDC, 0x00EE0, 0x00F00, 0x00F01, 0x00F40, 0x00F48, 0x00F49, 0x00F6D,
+    0x00F88, 0x00F8D, 0x01000, 0x0102B, 0x0103F, 0x01040, 0x01050, 0x01056,
+    0x0105A, 0x0105E, 0x01061, 0x01062, 0x01065, 0x01067, 0x0106E, 0x01071,
+    0x01075, 0x01082, 0x0108E, 0x0108F, 0x010A0, 0x010C6, 0x010C7, 0x010C8,
+    0x010CD, 0x010CE, 0x010D0, 0x010FB, 0x010FC, 0x01249, 0x0124A, 0x0124E,
+    0x01250, 0x01257, 0x01258, 0x01259, 0x0125A, 0x0125E, 0x01260, 0x01289,
+    0x0128A, 0x0128E, 0x01290, 0x012B1, 0x012B2, 0x012B6, 0x012B8, 0x012BF,
+    0x012C0, 0x012C1, 0x012C2, 0x012C6, 0x012C8, 0x012D7, 0x012D8, 0x01311,
+    0x01312, 0x01316, 0x01318, 0x0135B, 0x01380, 0x01390, 0x013A0, 0x013F6,
+    0x013F8, 0x013FE, 0x01401, 0x0166D, 0x0166F, 0x01680, 0x01681, 0x0169B,
+    0x016A0, 0x016EB, 0x016EE, 0x016F9, 0x01700, 0x01712, 0x0171F, 0x01732,
+    0x01740, 0x01752, 0x01760, 0x0176D, 0x0176E, 0x01771, 0x01780, 0x017B4,
+    0x017D7, 0x017D8, 0x017DC, 0x017DD, 0x01820, 0x01879, 0x01880, 0x018A9,
+    0x018AA, 0x018AB, 0x018B0, 0x018F6, 0x01900, 0x0191F, 0x01950, 0x0196E,
+    0x01970, 0x01975, 0x01980, 0x019AC, 0x019B0, 0x019CA, 0x01A00, 0x01A17,
+    0x01A20, 0x01A55, 0x01AA7, 0x01AA8, 0x01B05, 0x01B34, 0x01B45, 0x01B4D,
+    0x01B83, 0x01BA1, 0x01BAE, 0x01BB0, 0x01BBA, 0x01BE6, 0x01C00, 0x01C24,
+    0x01C4D, 0x01C50, 0x01C5A, 0x01C7E, 0x01C80, 0x01C89, 0x01C90, 0x01CBB,
+    0x01CBD, 0x01CC0, 0x01CE9, 0x01CED, 0x01CEE, 0x01CF4, 0x01CF5, 0x01CF7,
+    0x01CFA, 0x01CFB, 0x01D00, 0x01DC0, 0x01E00, 0x01F16, 0x01F18, 0x01F1E,
+    0x01F20, 0x01F46, 0x01F48, 0x01F4E, 0x01F50, 0x01F58, 0x01F59, 0x01F5A,
+    0x01F5B, 0x01F5C, 0x01F5D, 0x01F5E, 0x01F5F, 0x01F7E, 0x01F80, 0x01FB5,
+    0x01FB6, 0x01FBD, 0x01FBE, 0x01FBF, 0x01FC2, 0x01FC5, 0x01FC6, 0x01FCD,
+    0x01FD0, 0x01FD4, 0x01FD6, 0x01FDC, 0x01FE0, 0x01FED, 0x01FF2, 0x01FF5,
+    0x01FF6, 0x01FFD, 0x02071, 0x02072, 0x0207F, 0x02080, 0x02090, 0x0209D,
+    0x02102, 0x02103, 0x02107, 0x02108, 0x0210A, 0x02114, 0x02115, 0x02116,
+    0x02118, 0x0211E, 0x02124, 0x02125, 0x02126, 0x02127, 0x02128, 0x02129,
+    0x0212A, 0x0213A, 0x0213C, 0x02140, 0x02145, 0x0214A, 0x0214E, 0x0214F,
+    0x02160, 0x02189, 0x02C00, 0x02CE5, 0x02CEB, 0x02CEF, 0x02CF2, 0x02CF4,
+    0x02D00, 0x02D26, 0x02D27, 0x02D28, 0x02D2D, 0x02D2E, 0x02D30, 0x02D68,
+    0x02D6F, 0x02D70, 0x02D80, 0x02D97, 0x02DA0, 0x02DA7, 0x02DA8, 0x02DAF,
+    0x02DB0, 0x02DB7, 0x02DB8, 0x02DBF, 0x02DC0, 0x02DC7, 0x02DC8, 0x02DCF,
+    0x02DD0, 0x02DD7, 0x02DD8, 0x02DDF, 0x03005, 0x03008, 0x03021, 0x0302A,
+    0x03031, 0x03036, 0x03038, 0x0303D, 0x03041, 0x03097, 0x0309D, 0x030A0,
+    0x030A1, 0x030FB, 0x030FC, 0x03100, 0x03105, 0x03130, 0x03131, 0x0318F,
+    0x031A0, 0x031C0, 0x031F0, 0x03200, 0x03400, 0x04DC0, 0x04E00, 0x0A48D,
+    0x0A4D0, 0x0A4FE, 0x0A500, 0x0A60D, 0x0A610, 0x0A620, 0x0A62A, 0x0A62C,
+    0x0A640, 0x0A66F, 0x0A67F, 0x0A69E, 0x0A6A0, 0x0A6F0, 0x0A717, 0x0A720,
+    0x0A722, 0x0A789, 0x0A78B, 0x0A7CB, 0x0A7D0, 0x0A7D2, 0x0A7D3, 0x0A7D4,
+    0x0A7D5, 0x0A7DA, 0x0A7F2, 0x0A802, 0x0A803, 0x0A806, 0x0A807, 0x0A80B,
+    0x0A80C, 0x0A823, 0x0A840, 0x0A874, 0x0A882, 0x0A8B4, 0x0A8F2, 0x0A8F8,
+    0x0A8FB, 0x0A8FC, 0x0A8FD, 0x0A8FF, 0x0A90A, 0x0A926, 0x0A930, 0x0A947,
+    0x0A960, 0x0A97D, 0x0A984, 0x0A9B3, 0x0A9CF, 0x0A9D0, 0x0A9E0, 0x0A9E5,
+    0x0A9E6, 0x0A9F0, 0x0A9FA, 0x0A9FF, 0x0AA00, 0x0AA29, 0x0AA40, 0x0AA43,
+    0x0AA44, 0x0AA4C, 0x0AA60, 0x0AA77, 0x0AA7A, 0x0AA7B, 0x0AA7E, 0x0AAB0,
+    0x0AAB1, 0x0AAB2, 0x0AAB5, 0x0AAB7, 0x0AAB9, 0x0AABE, 0x0AAC0, 0x0AAC1,
+    0x0AAC2, 0x0AAC3, 0x0AADB, 0x0AADE, 0x0AAE0, 0x0AAEB, 0x0AAF2, 0x0AAF5,
+    0x0AB01, 0x0AB07, 0x0AB09, 0x0AB0F, 0x0AB11, 0x0AB17, 0x0AB20, 0x0AB27,
+    0x0AB28, 0x0AB2F, 0x0AB30, 0x0AB5B, 0x0AB5C, 0x0AB6A, 0x0AB70, 0x0ABE3,
+    0x0AC00, 0x0D7A4, 0x0D7B0, 0x0D7C7, 0x0D7CB, 0x0D7FC, 0x0F900, 0x0FA6E,
+    0x0FA70, 0x0FADA, 0x0FB00, 0x0FB07, 0x0FB13, 0x0FB18, 0x0FB1D, 0x0FB1E,
+    0x0FB1F, 0x0FB29, 0x0FB2A, 0x0FB37, 0x0FB38, 0x0FB3D, 0x0FB3E, 0x0FB3F,
+    0x0FB40, 0x0FB42, 0x0FB43, 0x0FB45, 0x0FB46, 0x0FBB2, 0x0FBD3, 0x0FC5E,
+    0x0FC64, 0x0FD3E, 0x0FD50, 0x0FD90, 0x0FD92, 0x0FDC8, 0x0FDF0, 0x0FDFA,
+    0x0FE71, 0x0FE72, 0x0FE73, 0x0FE74, 0x0FE77, 0x0FE78, 0x0FE79, 0x0FE7A,
+    0x0FE7B, 0x0FE7C, 0x0FE7D, 0x0FE7E, 0x0FE7F, 0x0FEFD, 0x0FF21, 0x0FF3B,
+    0x0FF41, 0x0FF5B, 0x0FF66, 0x0FF9E, 0x0FFA0, 0x0FFBF, 0x0FFC2, 0x0FFC8,
+    0x0FFCA, 0x0FFD0, 0x0FFD2, 0x0FFD8, 0x0FFDA, 0x0FFDD, 0x10000, 0x1000C,
+    0x1000D, 0x10027, 0x10028, 0x1003B, 0x1003C, 0x1003E, 0x1003F, 0x1004E,
+    0x10050, 0x1005E, 0x10080, 0x100FB, 0x10140, 0x10175, 0x10280, 0x1029D,
+    0x102A0, 0x102D1, 0x10300, 0x10320, 0x1032D, 0x1034B, 0x10350, 0x10376,
+    0x10380, 0x1039E, 0x103A0, 0x103C4, 0x103C8, 0x103D0, 0x103D1, 0x103D6,
+    0x10400, 0x1049E, 0x104B0, 0x104D4, 0x104D8, 0x104FC, 0x10500, 0x10528,
+    0x10530, 0x10564, 0x10570, 0x1057B, 0x1057C, 0x1058B, 0x1058C, 0x10593,
+    0x10594, 0x10596, 0x10597, 0x105A2, 0x105A3, 0x105B2, 0x105B3, 0x105BA,
+    0x105BB, 0x105BD, 0x10600, 0x10737, 0x10740, 0x10756, 0x10760, 0x10768,
+    0x10780, 0x10786, 0x10787, 0x107B1, 0x107B2, 0x107BB, 0x10800, 0x10806,
+    0x10808, 0x10809, 0x1080A, 0x10836, 0x10837, 0x10839, 0x1083C, 0x1083D,
+    0x1083F, 0x10856, 0x10860, 0x10877, 0x10880, 0x1089F, 0x108E0, 0x108F3,
+    0x108F4, 0x108F6, 0x10900, 0x10916, 0x10920, 0x1093A, 0x10980, 0x109B8,
+    0x109BE, 0x109C0, 0x10A00, 0x10A01, 0x10A10, 0x10A14, 0x10A15, 0x10A18,
+    0x10A19, 0x10A36, 0x10A60, 0x10A7D, 0x10A80, 0x10A9D, 0x10AC0, 0x10AC8,
+    0x10AC9, 0x10AE5, 0x10B00, 0x10B36, 0x10B40, 0x10B56, 0x10B60, 0x10B73,
+    0x10B80, 0x10B92, 0x10C00, 0x10C49, 0x10C80, 0x10CB3, 0x10CC0, 0x10CF3,
+    0x10D00, 0x10D24, 0x10E80, 0x10EAA, 0x10EB0, 0x10EB2, 0x10F00, 0x10F1D,
+    0x10F27, 0x10F28, 0x10F30, 0x10F46, 0x10F70, 0x10F82, 0x10FB0, 0x10FC5,
+    0x10FE0, 0x10FF7, 0x11003, 0x11038, 0x11071, 0x11073, 0x11075, 0x11076,
+    0x11083, 0x110B0, 0x110D0, 0x110E9, 0x11103, 0x11127, 0x11144, 0x11145,
+    0x11147, 0x11148, 0x11150, 0x11173, 0x11176, 0x11177, 0x11183, 0x111B3,
+    0x111C1, 0x111C5, 0x111DA, 0x111DB, 0x111DC, 0x111DD, 0x11200, 0x11212,
+    0x11213, 0x1122C, 0x11280, 0x11287, 0x11288, 0x11289, 0x1128A, 0x1128E,
+    0x1128F, 0x1129E, 0x1129F, 0x112A9, 0x112B0, 0x112DF, 0x11305, 0x1130D,
+    0x1130F, 0x11311, 0x11313, 0x11329, 0x1132A, 0x11331, 0x11332, 0x11334,
+    0x11335, 0x1133A, 0x1133D, 0x1133E, 0x11350, 0x11351, 0x1135D, 0x11362,
+    0x11400, 0x11435, 0x11447, 0x1144B, 0x1145F, 0x11462, 0x11480, 0x114B0,
+    0x114C4, 0x114C6, 0x114C7, 0x114C8, 0x11580, 0x115AF, 0x115D8, 0x115DC,
+    0x11600, 0x11630, 0x11644, 0x11645, 0x11680, 0x116AB, 0x116B8, 0x116B9,
+    0x11700, 0x1171B, 0x11740, 0x11747, 0x11800, 0x1182C, 0x118A0, 0x118E0,
+    0x118FF, 0x11907, 0x11909, 0x1190A, 0x1190C, 0x11914, 0x11915, 0x11917,
+    0x11918, 0x11930, 0x1193F, 0x11940, 0x11941, 0x11942, 0x119A0, 0x119A8,
+    0x119AA, 0x119D1, 0x119E1, 0x119E2, 0x119E3, 0x119E4, 0x11A00, 0x11A01,
+    0x11A0B, 0x11A33, 0x11A3A, 0x11A3B, 0x11A50, 0x11A51, 0x11A5C, 0x11A8A,
+    0x11A9D, 0x11A9E, 0x11AB0, 0x11AF9, 0x11C00, 0x11C09, 0x11C0A, 0x11C2F,
+    0x11C40, 0x11C41, 0x11C72, 0x11C90, 0x11D00, 0x11D07, 0x11D08, 0x11D0A,
+    0x11D0B, 0x11D31, 0x11D46, 0x11D47, 0x11D60, 0x11D66, 0x11D67, 0x11D69,
+    0x11D6A, 0x11D8A, 0x11D98, 0x11D99, 0x11EE0, 0x11EF3, 0x11FB0, 0x11FB1,
+    0x12000, 0x1239A, 0x12400, 0x1246F, 0x12480, 0x12544, 0x12F90, 0x12FF1,
+    0x13000, 0x1342F, 0x14400, 0x14647, 0x16800, 0x16A39, 0x16A40, 0x16A5F,
+    0x16A70, 0x16ABF, 0x16AD0, 0x16AEE, 0x16B00, 0x16B30, 0x16B40, 0x16B44,
+    0x16B63, 0x16B78, 0x16B7D, 0x16B90, 0x16E40, 0x16E80, 0x16F00, 0x16F4B,
+    0x16F50, 0x16F51, 0x16F93, 0x16FA0, 0x16FE0, 0x16FE2, 0x16FE3, 0x16FE4,
+    0x17000, 0x187F8, 0x18800, 0x18CD6, 0x18D00, 0x18D09, 0x1AFF0, 0x1AFF4,
+    0x1AFF5, 0x1AFFC, 0x1AFFD, 0x1AFFF, 0x1B000, 0x1B123, 0x1B150, 0x1B153,
+    0x1B164, 0x1B168, 0x1B170, 0x1B2FC, 0x1BC00, 0x1BC6B, 0x1BC70, 0x1BC7D,
+    0x1BC80, 0x1BC89, 0x1BC90, 0x1BC9A, 0x1D400, 0x1D455, 0x1D456, 0x1D49D,
+    0x1D49E, 0x1D4A0, 0x1D4A2, 0x1D4A3, 0x1D4A5, 0x1D4A7, 0x1D4A9, 0x1D4AD,
+    0x1D4AE, 0x1D4BA, 0x1D4BB, 0x1D4BC, 0x1D4BD, 0x1D4C4, 0x1D4C5, 0x1D506,
+    0x1D507, 0x1D50B, 0x1D50D, 0x1D515, 0x1D516, 0x1D51D, 0x1D51E, 0x1D53A,
+    0x1D53B, 0x1D53F, 0x1D540, 0x1D545, 0x1D546, 0x1D547, 0x1D54A, 0x1D551,
+    0x1D552, 0x1D6A6, 0x1D6A8, 0x1D6C1, 0x1D6C2, 0x1D6DB, 0x1D6DC, 0x1D6FB,
+    0x1D6FC, 0x1D715, 0x1D716, 0x1D735, 0x1D736, 0x1D74F, 0x1D750, 0x1D76F,
+    0x1D770, 0x1D789, 0x1D78A, 0x1D7A9, 0x1D7AA, 0x1D7C3, 0x1D7C4, 0x1D7CC,
+    0x1DF00, 0x1DF1F, 0x1E100, 0x1E12D, 0x1E137, 0x1E13E, 0x1E14E, 0x1E14F,
+    0x1E290, 0x1E2AE, 0x1E2C0, 0x1E2EC, 0x1E7E0, 0x1E7E7, 0x1E7E8, 0x1E7EC,
+    0x1E7ED, 0x1E7EF, 0x1E7F0, 0x1E7FF, 0x1E800, 0x1E8C5, 0x1E900, 0x1E944,
+    0x1E94B, 0x1E94C, 0x1EE00, 0x1EE04, 0x1EE05, 0x1EE20, 0x1EE21, 0x1EE23,
+    0x1EE24, 0x1EE25, 0x1EE27, 0x1EE28, 0x1EE29, 0x1EE33, 0x1EE34, 0x1EE38,
+    0x1EE39, 0x1EE3A, 0x1EE3B, 0x1EE3C, 0x1EE42, 0x1EE43, 0x1EE47, 0x1EE48,
+    0x1EE49, 0x1EE4A, 0x1EE4B, 0x1EE4C, 0x1EE4D, 0x1EE50, 0x1EE51, 0x1EE53,
+    0x1EE54, 0x1EE55, 0x1EE57, 0x1EE58, 0x1EE59, 0x1EE5A, 0x1EE5B, 0x1EE5C,
+    0x1EE5D, 0x1EE5E, 0x1EE5F, 0x1EE60, 0x1EE61, 0x1EE63, 0x1EE64, 0x1EE65,
+    0x1EE67, 0x1EE6B, 0x1EE6C, 0x1EE73, 0x1EE74, 0x1EE78, 0x1EE79, 0x1EE7D,
+    0x1EE7E, 0x1EE7F, 0x1EE80, 0x1EE8A, 0x1EE8B, 0x1EE9C, 0x1EEA1, 0x1EEA4,
+    0x1EEA5, 0x1EEAA, 0x1EEAB, 0x1EEBC, 0x20000, 0x2A6E0, 0x2A700, 0x2B739,
+    0x2B740, 0x2B81E, 0x2B820, 0x2CEA2, 0x2CEB0, 0x2EBE1, 0x2F800, 0x2FA1E,
+    0x30000, 0x3134B,
+};
+
+inline constexpr uint32_t continueBounds[] = {
+    0x000AA, 0x000AB, 0x000B5, 0x000B6, 0x000B7, 0x000B8, 0x000BA, 0x000BB,
+    0x000C0, 0x000D7, 0x000D8, 0x000F7, 0x000F8, 0x002C2, 0x002C6, 0x002D2,
+    0x002E0, 0x002E5, 0x002EC, 0x002ED, 0x002EE, 0x002EF, 0x00300, 0x00375,
+    0x00376, 0x00378, 0x0037B, 0x0037E, 0x0037F, 0x00380, 0x00386, 0x0038B,
+    0x0038C, 0x0038D, 0x0038E, 0x003A2, 0x003A3, 0x003F6, 0x003F7, 0x00482,
+    0x00483, 0x00488, 0x0048A, 0x00530, 0x00531, 0x00557, 0x00559, 0x0055A,
+    0x00560, 0x00589, 0x00591, 0x005BE, 0x005BF, 0x005C0, 0x005C1, 0x005C3,
+    0x005C4, 0x005C6, 0x005C7, 0x005C8, 0x005D0, 0x005EB, 0x005EF, 0x005F3,
+    0x00610, 0x0061B, 0x00620, 0x0066A, 0x0066E, 0x006D4, 0x006D5, 0x006DD,
+    0x006DF, 0x006E9, 0x006EA, 0x006FD, 0x006FF, 0x00700, 0x00710, 0x0074B,
+    0x0074D, 0x007B2, 0x007C0, 0x007F6, 0x007FA, 0x007FB, 0x007FD, 0x007FE,
+    0x00800, 0x0082E, 0x00840, 0x0085C, 0x00860, 0x0086B, 0x00870, 0x00888,
+    0x00889, 0x0088F, 0x00898, 0x008E2, 0x008E3, 0x00964, 0x00966, 0x00970,
+    0x00971, 0x00984, 0x00985, 0x0098D, 0x0098F, 0x00991, 0x00993, 0x009A9,
+    0x009AA, 0x009B1, 0x009B2, 0x009B3, 0x009B6, 0x009BA, 0x009BC, 0x009C5,
+    0x009C7, 0x009C9, 0x009CB, 0x009CF, 0x009D7, 0x009D8, 0x009DC, 0x009DE,
+    0x009DF, 0x009E4, 0x009E6, 0x009F2, 0x009FC, 0x009FD, 0x009FE, 0x009FF,
+    0x00A01, 0x00A04, 0x00A05, 0x00A0B, 0x00A0F, 0x00A11, 0x00A13, 0x00A29,
+    0x00A2A, 0x00A31, 0x00A32, 0x00A34, 0x00A35, 0x00A37, 0x00A38, 0x00A3A,
+    0x00A3C, 0x00A3D, 0x00A3E, 0x00A43, 0x00A47, 0x00A49, 0x00A4B, 0x00A4E,
+    0x00A51, 0x00A52, 0x00A59, 0x00A5D, 0x00A5E, 0x00A5F, 0x00A66, 0x00A76,
+    0x00A81, 0x00A84, 0x00A85, 0x00A8E, 0x00A8F, 0x00A92, 0x00A93, 0x00AA9,
+    0x00AAA, 0x00AB1, 0x00AB2, 0x00AB4, 0x00AB5, 0x00ABA, 0x00ABC, 0x00AC6,
+    0x00AC7, 0x00ACA, 0x00ACB, 0x00ACE, 0x00AD0, 0x00AD1, 0x00AE0, 0x00AE4,
+    0x00AE6, 0x00AF0, 0x00AF9, 0x00B00, 0x00B01, 0x00B04, 0x00B05, 0x00B0D,
+    0x00B0F, 0x00B11, 0x00B13, 0x00B29, 0x00B2A, 0x00B31, 0x00B32, 0x00B34,
+    0x00B35, 0x00B3A, 0x00B3C, 0x00B45, 0x00B47, 0x00B49, 0x00B4B, 0x00B4E,
+    0x00B55, 0x00B58, 0x00B5C, 0x00B5E, 0x00B5F, 0x00B64, 0x00B66, 0x00B70,
+    0x00B71, 0x00B72, 0x00B82, 0x00B84, 0x00B85, 0x00B8B, 0x00B8E, 0x00B91,
+    0x00B92, 0x00B96, 0x00B99, 0x00B9B, 0x00B9C, 0x00B9D, 0x00B9E, 0x00BA0,
+    0x00BA3, 0x00BA5, 0x00BA8, 0x00BAB, 0x00BAE, 0x00BBA, 0x00BBE, 0x00BC3,
+    0x00BC6, 0x00BC9, 0x00BCA, 0x00BCE, 0x00BD0, 0x00BD1, 0x00BD7, 0x00BD8,
+    0x00BE6, 0x00BF0, 0x00C00, 0x00C0D, 0x00C0E, 0x00C11, 0x00C12, 0x00C29,
+    0x00C2A, 0x00C3A, 0x00C3C, 0x00C45, 0x00C46, 0x00C49, 0x00C4A, 0x00C4E,
+    0x00C55, 0x00C57, 0x00C58, 0x00C5B, 0x00C5D, 0x00C5E, 0x00C60, 0x00C64,
+    0x00C66, 0x00C70, 0x00C80, 0x00C84, 0x00C85, 0x00C8D, 0x00C8E, 0x00C91,
+    0x00C92, 0x00CA9, 0x00CAA, 0x00CB4, 0x00CB5, 0x00CBA, 0x00CBC, 0x00CC5,
+    0x00CC6, 0x00CC9, 0x00CCA, 0x00CCE, 0x00CD5, 0x00CD7, 0x00CDD, 0x00CDF,
+    0x00CE0, 0x00CE4, 0x00CE6, 0x00CF0, 0x00CF1, 0x00CF3, 0x00D00, 0x00D0D,
+    0x00D0E, 0x00D11, 0x00D12, 0x00D45, 0x00D46, 0x00D49, 0x00D4A, 0x00D4F,
+    0x00D54, 0x00D58, 0x00D5F, 0x00D64, 0x00D66, 0x00D70, 0x00D7A, 0x00D80,
+    0x00D81, 0x00D84, 0x00D85, 0x00D97, 0x00D9A, 0x00DB2, 0x00DB3, 0x00DBC,
+    0x00DBD, 0x00DBE, 0x00DC0, 0x00DC7, 0x00DCA, 0x00DCB, 0x00DCF, 0x00DD5,
+    0x00DD6, 0x00DD7, 0x00DD8, 0x00DE0, 0x00DE6, 0x00DF0, 0x00DF2, 0x00DF4,
+    0x00E01, 0x00E3B, 0x00E40, 0x00E4F, 0x00E50, 0x00E5A, 0x00E81, 0x00E83,
+    0x00E84, 0x00E85, 0x00E86, 0x00E8B, 0x00E8C, 0x00EA4, 0x00EA5, 0x00EA6,
+    0x00EA7, 0x00EBE, 0x00EC0, 0x00EC5, 0x00EC6, 0x00EC7, 0x00EC8, 0x00ECE,
+    0x00ED0, 0x00EDA, 0x00EDC, 0x00EE0, 0x00F00, 0x00F01, 0x00F18, 0x00F1A,
+    0x00F20, 0x00F2A, 0x00F35, 0x00F36, 0x00F37, 0x00F38, 0x00F39, 0x00F3A,
+    0x00F3E, 0x00F48, 0x00F49, 0x00F6D, 0x00F71, 0x00F85, 0x00F86, 0x00F98,
+    0x00F99, 0x00FBD, 0x00FC6, 0x00FC7, 0x01000, 0x0104A, 0x01050, 0x0109E,
+    0x010A0, 0x010C6, 0x010C7, 0x010C8, 0x010CD, 0x010CE, 0x010D0, 0x010FB,
+    0x010FC, 0x01249, 0x0124A, 0x0124E, 0x01250, 0x01257, 0x01258, 0x01259,
+    0x0125A, 0x0125E, 0x01260, 0x01289, 0x0128A, 0x0128E, 0x01290, 0x012B1,
+    0x012B2, 0x012B6, 0x012B8, 0x012BF, 0x012C0, 0x012C1, 0x012C2, 0x012C6,
+    0x012C8, 0x012D7, 0x012D8, 0x01311, 0x01312, 0x01316, 0x01318, 0x0135B,
+    0x0135D, 0x01360, 0x01369, 0x01372, 0x01380, 0x01390, 0x013A0, 0x013F6,
+    0x013F8, 0x013FE, 0x01401, 0x0166D, 0x0166F, 0x01680, 0x01681, 0x0169B,
+    0x016A0, 0x016EB, 0x016EE, 0x016F9, 0x01700, 0x01716, 0x0171F, 0x01735,
+    0x01740, 0x01754, 0x01760, 0x0176D, 0x0176E, 0x01771, 0x01772, 0x01774,
+    0x01780, 0x017D4, 0x017D7, 0x017D8, 0x017DC, 0x017DE, 0x017E0, 0x017EA,
+    0x0180B, 0x0180E, 0x0180F, 0x0181A, 0x01820, 0x01879, 0x01880, 0x018AB,
+    0x018B0, 0x018F6, 0x01900, 0x0191F, 0x01920, 0x0192C, 0x01930, 0x0193C,
+    0x01946, 0x0196E, 0x01970, 0x01975, 0x01980, 0x019AC, 0x019B0, 0x019CA,
+    0x019D0, 0x019DB, 0x01A00, 0x01A1C, 0x01A20, 0x01A5F, 0x01A60, 0x01A7D,
+    0x01A7F, 0x01A8A, 0x01A90, 0x01A9A, 0x01AA7, 0x01AA8, 0x01AB0, 0x01ABE,
+    0x01ABF, 0x01ACF, 0x01B00, 0x01B4D, 0x01B50, 0x01B5A, 0x01B6B, 0x01B74,
+    0x01B80, 0x01BF4, 0x01C00, 0x01C38, 0x01C40, 0x01C4A, 0x01C4D, 0x01C7E,
+    0x01C80, 0x01C89, 0x01C90, 0x01CBB, 0x01CBD, 0x01CC0, 0x01CD0, 0x01CD3,
+    0x01CD4, 0x01CFB, 0x01D00, 0x01F16, 0x01F18, 0x01F1E, 0x01F20, 0x01F46,
+    0x01F48, 0x01F4E, 0x01F50, 0x01F58, 0x01F59, 0x01F5A, 0x01F5B, 0x01F5C,
+    0x01F5D, 0x01F5E, 0x01F5F, 0x01F7E, 0x01F80, 0x01FB5, 0x01FB6, 0x01FBD,
+    0x01FBE, 0x01FBF, 0x01FC2, 0x01FC5, 0x01FC6, 0x01FCD, 0x01FD0, 0x01FD4,
+    0x01FD6, 0x01FDC, 0x01FE0, 0x01FED, 0x01FF2, 0x01FF5, 0x01FF6, 0x01FFD,
+    0x0203F, 0x02041, 0x02054, 0x02055, 0x02071, 0x02072, 0x0207F, 0x02080,
+    0x02090, 0x0209D, 0x020D0, 0x020DD, 0x020E1, 0x020E2, 0x020E5, 0x020F1,
+    0x02102, 0x02103, 0x02107, 0x02108, 0x0210A, 0x02114, 0x02115, 0x02116,
+    0x02118, 0x0211E, 0x02124, 0x02125, 0x02126, 0x02127, 0x02128, 0x02129,
+    0x0212A, 0x0213A, 0x0213C, 0x02140, 0x02145, 0x0214A, 0x0214E, 0x0214F,
+    0x02160, 0x02189, 0x02C00, 0x02CE5, 0x02CEB, 0x02CF4, 0x02D00, 0x02D26,
+    0x02D27, 0x02D28, 0x02D2D, 0x02D2E, 0x02D30, 0x02D68, 0x02D6F, 0x02D70,
+    0x02D7F, 0x02D97, 0x02DA0, 0x02DA7, 0x02DA8, 0x02DAF, 0x02DB0, 0x02DB7,
+    0x02DB8, 0x02DBF, 0x02DC0, 0x02DC7, 0x02DC8, 0x02DCF, 0x02DD0, 0x02DD7,
+    0x02DD8, 0x02DDF, 0x02DE0, 0x02E00, 0x03005, 0x03008, 0x03021, 0x03030,
+    0x03031, 0x03036, 0x03038, 0x0303D, 0x03041, 0x03097, 0x03099, 0x0309B,
+    0x0309D, 0x030A0, 0x030A1, 0x030FB, 0x030FC, 0x03100, 0x03105, 0x03130,
+    0x03131, 0x0318F, 0x031A0, 0x031C0, 0x031F0, 0x03200, 0x03400, 0x04DC0,
+    0x04E00, 0x0A48D, 0x0A4D0, 0x0A4FE, 0x0A500, 0x0A60D, 0x0A610, 0x0A62C,
+    0x0A640, 0x0A670, 0x0A674, 0x0A67E, 0x0A67F, 0x0A6F2, 0x0A717, 0x0A720,
+    0x0A722, 0x0A789, 0x0A78B, 0x0A7CB, 0x0A7D0, 0x0A7D2, 0x0A7D3, 0x0A7D4,
+    0x0A7D5, 0x0A7DA, 0x0A7F2, 0x0A828, 0x0A82C, 0x0A82D, 0x0A840, 0x0A874,
+    0x0A880, 0x0A8C6, 0x0A8D0, 0x0A8DA, 0x0A8E0, 0x0A8F8, 0x0A8FB, 0x0A8FC,
+    0x0A8FD, 0x0A92E, 0x0A930, 0x0A954, 0x0A960, 0x0A97D, 0x0A980, 0x0A9C1,
+    0x0A9CF, 0x0A9DA, 0x0A9E0, 0x0A9FF, 0x0AA00, 0x0AA37, 0x0AA40, 0x0AA4E,
+    0x0AA50, 0x0AA5A, 0x0AA60, 0x0AA77, 0x0AA7A, 0x0AAC3, 0x0AADB, 0x0AADE,
+    0x0AAE0, 0x0AAF0, 0x0AAF2, 0x0AAF7, 0x0AB01, 0x0AB07, 0x0AB09, 0x0AB0F,
+    0x0AB11, 0x0AB17, 0x0AB20, 0x0AB27, 0x0AB28, 0x0AB2F, 0x0AB30, 0x0AB5B,
+    0x0AB5C, 0x0AB6A, 0x0AB70, 0x0ABEB, 0x0ABEC, 0x0ABEE, 0x0ABF0, 0x0ABFA,
+    0x0AC00, 0x0D7A4, 0x0D7B0, 0x0D7C7, 0x0D7CB, 0x0D7FC, 0x0F900, 0x0FA6E,
+    0x0FA70, 0x0FADA, 0x0FB00, 0x0FB07, 0x0FB13, 0x0FB18, 0x0FB1D, 0x0FB29,
+    0x0FB2A, 0x0FB37, 0x0FB38, 0x0FB3D, 0x0FB3E, 0x0FB3F, 0x0FB40, 0x0FB42,
+    0x0FB43, 0x0FB45, 0x0FB46, 0x0FBB2, 0x0FBD3, 0x0FC5E, 0x0FC64, 0x0FD3E,
+    0x0FD50, 0x0FD90, 0x0FD92, 0x0FDC8, 0x0FDF0, 0x0FDFA, 0x0FE00, 0x0FE10,
+    0x0FE20, 0x0FE30, 0x0FE33, 0x0FE35, 0x0FE4D, 0x0FE50, 0x0FE71, 0x0FE72,
+    0x0FE73, 0x0FE74, 0x0FE77, 0x0FE78, 0x0FE79, 0x0FE7A, 0x0FE7B, 0x0FE7C,
+    0x0FE7D, 0x0FE7E, 0x0FE7F, 0x0FEFD, 0x0FF10, 0x0FF1A, 0x0FF21, 0x0FF3B,
+    0x0FF3F, 0x0FF40, 0x0FF41, 0x0FF5B, 0x0FF66, 0x0FFBF, 0x0FFC2, 0x0FFC8,
+    0x0FFCA, 0x0FFD0, 0x0FFD2, 0x0FFD8, 0x0FFDA, 0x0FFDD, 0x10000, 0x1000C,
+    0x1000D, 0x10027, 0x10028, 0x1003B, 0x1003C, 0x1003E, 0x1003F, 0x1004E,
+    0x10050, 0x1005E, 0x10080, 0x100FB, 0x10140, 0x10175, 0x101FD, 0x101FE,
+    0x10280, 0x1029D, 0x102A0, 0x102D1, 0x102E0, 0x102E1, 0x10300, 0x10320,
+    0x1032D, 0x1034B, 0x10350, 0x1037B, 0x10380, 0x1039E, 0x103A0, 0x103C4,
+    0x103C8, 0x103D0, 0x103D1, 0x103D6, 0x10400, 0x1049E, 0x104A0, 0x104AA,
+    0x104B0, 0x104D4, 0x104D8, 0x104FC, 0x10500, 0x10528, 0x10530, 0x10564,
+    0x10570, 0x1057B, 0x1057C, 0x1058B, 0x1058C, 0x10593, 0x10594, 0x10596,
+    0x10597, 0x105A2, 0x105A3, 0x105B2, 0x105B3, 0x105BA, 0x105BB, 0x105BD,
+    0x10600, 0x10737, 0x10740, 0x10756, 0x10760, 0x10768, 0x10780, 0x10786,
+    0x10787, 0x107B1, 0x107B2, 0x107BB, 0x10800, 0x10806, 0x10808, 0x10809,
+    0x1080A, 0x10836, 0x10837, 0x10839, 0x1083C, 0x1083D, 0x1083F, 0x10856,
+    0x10860, 0x10877, 0x10880, 0x1089F, 0x108E0, 0x108F3, 0x108F4, 0x108F6,
+    0x10900, 0x10916, 0x10920, 0x1093A, 0x10980, 0x109B8, 0x109BE, 0x109C0,
+    0x10A00, 0x10A04, 0x10A05, 0x10A07, 0x10A0C, 0x10A14, 0x10A15, 0x10A18,
+    0x10A19, 0x10A36, 0x10A38, 0x10A3B, 0x10A3F, 0x10A40, 0x10A60, 0x10A7D,
+    0x10A80, 0x10A9D, 0x10AC0, 0x10AC8, 0x10AC9, 0x10AE7, 0x10B00, 0x10B36,
+    0x10B40, 0x10B56, 0x10B60, 0x10B73, 0x10B80, 0x10B92, 0x10C00, 0x10C49,
+    0x10C80, 0x10CB3, 0x10CC0, 0x10CF3, 0x10D00, 0x10D28, 0x10D30, 0x10D3A,
+    0x10E80, 0x10EAA, 0x10EAB, 0x10EAD, 0x10EB0, 0x10EB2, 0x10F00, 0x10F1D,
+    0x10F27, 0x10F28, 0x10F30, 0x10F51, 0x10F70, 0x10F86, 0x10FB0, 0x10FC5,
+    0x10FE0, 0x10FF7, 0x11000, 0x11047, 0x11066, 0x11076, 0x1107F, 0x110BB,
+    0x110C2, 0x110C3, 0x110D0, 0x110E9, 0x110F0, 0x110FA, 0x11100, 0x11135,
+    0x11136, 0x11140, 0x11144, 0x11148, 0x11150, 0x11174, 0x11176, 0x11177,
+    0x11180, 0x111C5, 0x111C9, 0x111CD, 0x111CE, 0x111DB, 0x111DC, 0x111DD,
+    0x11200, 0x11212, 0x11213, 0x11238, 0x1123E, 0x1123F, 0x11280, 0x11287,
+    0x11288, 0x11289, 0x1128A, 0x1128E, 0x1128F, 0x1129E, 0x1129F, 0x112A9,
+    0x112B0, 0x112EB, 0x112F0, 0x112FA, 0x11300, 0x11304, 0x11305, 0x1130D,
+    0x1130F, 0x11311, 0x11313, 0x11329, 0x1132A, 0x11331, 0x11332, 0x11334,
+    0x11335, 0x1133A, 0x1133B, 0x11345, 0x11347, 0x11349, 0x1134B, 0x1134E,
+    0x11350, 0x11351, 0x11357, 0x11358, 0x1135D, 0x11364, 0x11366, 0x1136D,
+    0x11370, 0x11375, 0x11400, 0x1144B, 0x11450, 0x1145A, 0x1145E, 0x11462,
+    0x11480, 0x114C6, 0x114C7, 0x114C8, 0x114D0, 0x114DA, 0x11580, 0x115B6,
+    0x115B8, 0x115C1, 0x115D8, 0x115DE, 0x11600, 0x11641, 0x11644, 0x11645,
+    0x11650, 0x1165A, 0x11680, 0x116B9, 0x116C0, 0x116CA, 0x11700, 0x1171B,
+    0x1171D, 0x1172C, 0x11730, 0x1173A, 0x11740, 0x11747, 0x11800, 0x1183B,
+    0x118A0, 0x118EA, 0x118FF, 0x11907, 0x11909, 0x1190A, 0x1190C, 0x11914,
+    0x11915, 0x11917, 0x11918, 0x11936, 0x11937, 0x11939, 0x1193B, 0x11944,
+    0x11950, 0x1195A, 0x119A0, 0x119A8, 0x119AA, 0x119D8, 0x119DA, 0x119E2,
+    0x119E3, 0x119E5, 0x11A00, 0x11A3F, 0x11A47, 0x11A48, 0x11A50, 0x11A9A,
+    0x11A9D, 0x11A9E, 0x11AB0, 0x11AF9, 0x11C00, 0x11C09, 0x11C0A, 0x11C37,
+    0x11C38, 0x11C41, 0x11C50, 0x11C5A, 0x11C72, 0x11C90, 0x11C92, 0x11CA8,
+    0x11CA9, 0x11CB7, 0x11D00, 0x11D07, 0x11D08, 0x11D0A, 0x11D0B, 0x11D37,
+    0x11D3A, 0x11D3B, 0x11D3C, 0x11D3E, 0x11D3F, 0x11D48, 0x11D50, 0x11D5A,
+    0x11D60, 0x11D66, 0x11D67, 0x11D69, 0x11D6A, 0x11D8F, 0x11D90, 0x11D92,
+    0x11D93, 0x11D99, 0x11DA0, 0x11DAA, 0x11EE0, 0x11EF7, 0x11FB0, 0x11FB1,
+    0x12000, 0x1239A, 0x12400, 0x1246F, 0x12480, 0x12544, 0x12F90, 0x12FF1,
+    0x13000, 0x1342F, 0x14400, 0x14647, 0x16800, 0x16A39, 0x16A40, 0x16A5F,
+    0x16A60, 0x16A6A, 0x16A70, 0x16ABF, 0x16AC0, 0x16ACA, 0x16AD0, 0x16AEE,
+    0x16AF0, 0x16AF5, 0x16B00, 0x16B37, 0x16B40, 0x16B44, 0x16B50, 0x16B5A,
+    0x16B63, 0x16B78, 0x16B7D, 0x16B90, 0x16E40, 0x16E80, 0x16F00, 0x16F4B,
+    0x16F4F, 0x16F88, 0x16F8F, 0x16FA0, 0x16FE0, 0x16FE2, 0x16FE3, 0x16FE5,
+    0x16FF0, 0x16FF2, 0x17000, 0x187F8, 0x18800, 0x18CD6, 0x18D00, 0x18D09,
+    0x1AFF0, 0x1AFF4, 0x1AFF5, 0x1AFFC, 0x1AFFD, 0x1AFFF, 0x1B000, 0x1B123,
+    0x1B150, 0x1B153, 0x1B164, 0x1B168, 0x1B170, 0x1B2FC, 0x1BC00, 0x1BC6B,
+    0x1BC70, 0x1BC7D, 0x1BC80, 0x1BC89, 0x1BC90, 0x1BC9A, 0x1BC9D, 0x1BC9F,
+    0x1CF00, 0x1CF2E, 0x1CF30, 0x1CF47, 0x1D165, 0x1D16A, 0x1D16D, 0x1D173,
+    0x1D17B, 0x1D183, 0x1D185, 0x1D18C, 0x1D1AA, 0x1D1AE, 0x1D242, 0x1D245,
+    0x1D400, 0x1D455, 0x1D456, 0x1D49D, 0x1D49E, 0x1D4A0, 0x1D4A2, 0x1D4A3,
+    0x1D4A5, 0x1D4A7, 0x1D4A9, 0x1D4AD, 0x1D4AE, 0x1D4BA, 0x1D4BB, 0x1D4BC,
+    0x1D4BD, 0x1D4C4, 0x1D4C5, 0x1D506, 0x1D507, 0x1D50B, 0x1D50D, 0x1D515,
+    0x1D516, 0x1D51D, 0x1D51E, 0x1D53A, 0x1D53B, 0x1D53F, 0x1D540, 0x1D545,
+    0x1D546, 0x1D547, 0x1D54A, 0x1D551, 0x1D552, 0x1D6A6, 0x1D6A8, 0x1D6C1,
+    0x1D6C2, 0x1D6DB, 0x1D6DC, 0x1D6FB, 0x1D6FC, 0x1D715, 0x1D716, 0x1D735,
+    0x1D736, 0x1D74F, 0x1D750, 0x1D76F, 0x1D770, 0x1D789, 0x1D78A, 0x1D7A9,
+    0x1D7AA, 0x1D7C3, 0x1D7C4, 0x1D7CC, 0x1D7CE, 0x1D800, 0x1DA00, 0x1DA37,
+    0x1DA3B, 0x1DA6D, 0x1DA75, 0x1DA76, 0x1DA84, 0x1DA85, 0x1DA9B, 0x1DAA0,
+    0x1DAA1, 0x1DAB0, 0x1DF00, 0x1DF1F, 0x1E000, 0x1E007, 0x1E008, 0x1E019,
+    0x1E01B, 0x1E022, 0x1E023, 0x1E025, 0x1E026, 0x1E02B, 0x1E100, 0x1E12D,
+    0x1E130, 0x1E13E, 0x1E140, 0x1E14A, 0x1E14E, 0x1E14F, 0x1E290, 0x1E2AF,
+    0x1E2C0, 0x1E2FA, 0x1E7E0, 0x1E7E7, 0x1E7E8, 0x1E7EC, 0x1E7ED, 0x1E7EF,
+    0x1E7F0, 0x1E7FF, 0x1E800, 0x1E8C5, 0x1E8D0, 0x1E8D7, 0x1E900, 0x1E94C,
+    0x1E950, 0x1E95A, 0x1EE00, 0x1EE04, 0x1EE05, 0x1EE20, 0x1EE21, 0x1EE23,
+    0x1EE24, 0x1EE25, 0x1EE27, 0x1EE28, 0x1EE29, 0x1EE33, 0x1EE34, 0x1EE38,
+    0x1EE39, 0x1EE3A, 0x1EE3B, 0x1EE3C, 0x1EE42, 0x1EE43, 0x1EE47, 0x1EE48,
+    0x1EE49, 0x1EE4A, 0x1EE4B, 0x1EE4C, 0x1EE4D, 0x1EE50, 0x1EE51, 0x1EE53,
+    0x1EE54, 0x1EE55, 0x1EE57, 0x1EE58, 0x1EE59, 0x1EE5A, 0x1EE5B, 0x1EE5C,
+    0x1EE5D, 0x1EE5E, 0x1EE5F, 0x1EE60, 0x1EE61, 0x1EE63, 0x1EE64, 0x1EE65,
+    0x1EE67, 0x1EE6B, 0x1EE6C, 0x1EE73, 0x1EE74, 0x1EE78, 0x1EE79, 0x1EE7D,
+    0x1EE7E, 0x1EE7F, 0x1EE80, 0x1EE8A, 0x1EE8B, 0x1EE9C, 0x1EEA1, 0x1EEA4,
+    0x1EEA5, 0x1EEAA, 0x1EEAB, 0x1EEBC, 0x1FBF0, 0x1FBFA, 0x20000, 0x2A6E0,
+    0x2A700, 0x2B739, 0x2B740, 0x2B81E, 0x2B820, 0x2CEA2, 0x2CEB0, 0x2EBE1,
+    0x2F800, 0x2FA1E, 0x30000, 0x3134B, 0xE0100, 0xE01F0,
+};
+
+} // namespace unicode_xid
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef UTF8_H
+#define UTF8_H
+
+#include <algorithm>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include "char_scan.h"
+#include "unicode_xid.h"
+
+// UTF-8 validation and Unicode identifiers. ASCII is the common case, so
+// validation skips 16 or 32 ASCII bytes per step and only decodes around
+// non-ASCII bytes; identifier scanning stays on skipWord until it meets a
+// byte >= 0x80.
+
+// Decodes the well-formed sequence at s[i] into cp and returns its length,
+// or 0 if the bytes there are not valid UTF-8 (bad lead byte, truncated,
+// overlong, surrogate or above U+10FFFF).
+inline size_t decodeUtf8(std::string_view s, size_t i, uint32_t& cp) {
+    const size_t n = s.size();
+    unsigned char c = s[i];
+    if (c < 0x80) {
+        cp = c;
+        return 1;
+    }
+    size_t len;
+    unsigned char lo = 0x80, hi = 0xBF; // allowed range of the second byte
+    if (c >= 0xC2 && c <= 0xDF) len = 2, cp = c & 0x1F;
+    else if (c >= 0xE0 && c <= 0xEF) {
+        len = 3, cp = c & 0x0F;
+        if (c == 0xE0) lo = 0xA0;
+        if (c == 0xED) hi = 0x9F;
+    } else if (c >= 0xF0 && c <= 0xF4) {
+        len = 4, cp = c & 0x07;
+        if (c == 0xF0) lo = 0x90;
+        if (c == 0xF4) hi = 0x8F;
+    } else {
+        return 0;
+    }
+    if (i + len > n) return 0;
+    for (size_t k = 1; k < len; ++k) {
+        unsigned char b = s[i + k];
+        if (k == 1 ? (b < lo || b > hi) : (b & 0xC0) != 0x80) return 0;
+        cp = (cp << 6) | (b & 0x3F);
+    }
+    return len;
+}
+
+namespace utf8 {
+
+// Index of the first byte >= 0x80 at or after i, or n.
+inline size_t scalarSkipAscii(const char* p, size_t i, size_t n) {
+    while (i < n && (unsigned char)p[i] < 0x80) ++i;
+    return i;
+}
+
+#ifdef CHAR_SCAN_X86
+
+inline size_t sse2SkipAscii(const char* p, size_t i, size_t n) {
+    while (i + 16 <= n) {
+        unsigned high = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)));
+        if (high) return i + __builtin_ctz(high);
+        i += 16;
+    }
+    return scalarSkipAscii(p, i, n);
+}
+
+__attribute__((target("avx2"))) inline size_t avx2SkipAscii(const char* p, size_t i, size_t n) {
+    while (i + 32 <= n) {
+        unsigned high = _mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)));
+        if (high) return i + __builtin_ctz(high);
+        i += 32;
+    }
+    return sse2SkipAscii(p, i, n);
+}
+
+#endif
+
+inline size_t skipAscii(std::string_view s, size_t i) {
+#ifdef CHAR_SCAN_X86
+    if (scanMode == SCAN_AVX2) return avx2SkipAscii(s.data(), i, s.size());
+    if (scanMode == SCAN_SSE2) return sse2SkipAscii(s.data(), i, s.size());
+#endif
+    return scalarSkipAscii(s.data(), i, s.size());
+}
+
+inline bool inBounds(const uint32_t* first, const uint32_t* last, uint32_t cp) {
+    return (std::upper_bound(first, last, cp) - first) & 1;
+}
+
+} // namespace utf8
+
+// Offset of the first byte that is not part of valid UTF-8, or npos.
+inline size_t firstInvalidUtf8(std::string_view s) {
+    size_t i = 0;
+    uint32_t cp;
+    while ((i = utf8::skipAscii(s, i)) < s.size()) {
+        size_t len = decodeUtf8(s, i, cp);
+        if (len == 0) return i;
+        i += len;
+    }
+    return std::string_view::npos;
+}
+
+// Warns about the first invalid UTF-8 byte in source, if any. Lexers still
+// run over such input; the bad bytes come out as invalid tokens.
+inline void reportInvalidUtf8(std::string_view source, std::ostream& errors) {
+    size_t bad = firstInvalidUtf8(source);
+    if (bad == std::string_view::npos) return;
+    long line = 1 + std::count(source.begin(), source.begin() + bad, '\n');
+    errors << "Warning: Invalid UTF-8 at line " << line << " (byte offset " << bad << ")\n";
+}
+
+inline bool isXidStart(uint32_t cp) {
+    if (cp < 0x80) return ((cp | 0x20) >= 'a' && (cp | 0x20) <= 'z');
+    return utf8::inBounds(std::begin(unicode_xid::startBounds), std::end(unicode_xid::startBounds), cp);
+}
+
+inline bool isXidContinue(uint32_t cp) {
+    if (cp < 0x80) return ((cp | 0x20) >= 'a' && (cp | 0x20) <= 'z') || (cp >= '0' && cp <= '9') || cp == '_';
+    return utf8::inBounds(std::begin(unicode_xid::continueBounds), std::end(unicode_xid::continueBounds), cp);
+}
+
+// Length of the character at s[i] if it can start (or continue) an
+// identifier, otherwise 0. '_' may start one, as in C.
+inline size_t identStartLength(std::string_view s, size_t i) {
+    uint32_t cp;
+    size_t len = decodeUtf8(s, i, cp);
+    return len && (cp == '_' || isXidStart(cp)) ? len : 0;
+}
+
+inline size_t identContinueLength(std::string_view s, size_t i) {
+    uint32_t cp;
+    size_t len = decodeUtf8(s, i, cp);
+    return len && isXidContinue(cp) ? len : 0;
+}
+
+// [XID_Start_][XID_Continue]*
+inline bool isIdentifier(std::string_view token) {
+    size_t len = token.empty() ? 0 : identStartLength(token, 0);
+    if (len == 0) return false;
+    for (size_t i = len; i < token.size(); i += len)
+        if ((len = identContinueLength(token, i)) == 0) return false;
+    return true;
+}
+
+// Like skipWord, but also takes in non-ASCII XID_Continue characters.
+inline size_t skipUnicodeWord(std::string_view s, size_t i) {
+    for (;;) {
+        i = skipWord(s, i);
+        if (i >= s.size() || (unsigned char)s[i] < 0x80) return i;
+        size_t len = identContinueLength(s, i);
+        if (len == 0) return i;
+        i += len;
+    }
+}
+
+// Length of the character at s[i]: its UTF-8 sequence, or 1 for a stray byte.
+inline size_t charLength(std::string_view s, size_t i) {
+    uint32_t cp;
+    return std::max<size_t>(decodeUtf8(s, i, cp), 1);
+}
+
+#endif
@@ -0,0 +1,371 @@
+#ifndef XREF_INDEX_H
+#define XREF_INDEX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+#include <vector>
+#include "mapped_file.h"
+#include "string_interner.h"
+
+// Cross-reference index: every occurrence of every symbol as (file, byte
+// offset), stored twice so both directions are fast:
+//   - per symbol, a posting list of (file delta, offset delta) varints in
+//     file and offset order, for "all uses of X";
+//   - per file, a stream of (offset delta, symbol) varints in offset order,
+//     restarting every SKIP_INTERVAL entries so a skip table can jump to
+//     the right block, for "symbol at offset Y".
+// Symbols are sorted by lexeme and found by binary search. Every section is
+// 8-byte aligned, so the file is used in place through mmap.
+
+namespace xref {
+
+constexpr char MAGIC[4] = {'X', 'R', 'E', 'F'};
+constexpr uint32_t VERSION = 1;
+constexpr uint32_t SKIP_INTERVAL = 64;
+constexpr uint32_t NOT_FOUND = UINT32_MAX;
+
+enum Section {
+    FILE_NAME_STARTS, FILE_NAME_BYTES, FILE_OCC_STARTS, FILE_SKIP_STARTS, SKIPS, FILE_STREAM,
+    SYMBOL_LEXEME_STARTS, SYMBOL_LEXEME_BYTES, SYMBOL_KINDS, POSTING_STARTS, POSTINGS, SECTION_COUNT
+};
+
+struct Header {
+    char magic[4];
+    uint32_t version;
+    uint64_t fileCount;
+    uint64_t symbolCount;
+    uint64_t occurrenceCount;
+    uint64_t sections[SECTION_COUNT + 1]; // byte offset of each section, then the file size
+};
+
+// Start of a block of SKIP_INTERVAL entries in the file stream.
+struct Skip {
+    uint64_t firstOffset;
+    uint64_t bytePos;
+};
+
+inline void putVarint(std::string& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back((char)(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back((char)v);
+}
+
+// Reads a varint that must end before end; false if it runs past end or
+// is longer than 64 bits.
+inline bool getVarint(const unsigned char*& p, const unsigned char* end, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        unsigned char b = *p++;
+        v |= (uint64_t)(b & 0x7F) << shift;
+        if (b < 0x80) return true;
+    }
+    return false;
+}
+
+} // namespace xref
+
+// Collects occurrences file by file and writes the index.
+class XrefBuilder {
+public:
+    // Adds a file's occurrences. occurrences holds (local symbol ID, offset)
+    // pairs whose IDs refer to names, in any order; kinds[id] is stored for
+    // symbols not seen in earlier files.
+    void addFile(const std::string& name, const StringInterner& names, const std::vector<unsigned char>& localKinds,
+                 std::vector<std::pair<uint32_t, uint64_t>> occurrences) {
+        uint32_t file = files.size();
+        files.push_back(name);
+        std::vector<uint32_t> global(names.size());
+        for (uint32_t id = 0; id < names.size(); ++id) {
+            bool inserted;
+            global[id] = symbols.intern(names.lexeme(id), inserted);
+            if (inserted) kinds.push_back(localKinds[id]);
+        }
+        std::stable_sort(occurrences.begin(), occurrences.end(),
+                         [](const auto& a, const auto& b) { return a.second < b.second; });
+        fileOccStart.push_back(occs.size());
+        for (auto& o : occurrences) occs.push_back({file, global[o.first], o.second});
+    }
+
+    size_t occurrenceCount() const { return occs.size(); }
+    uint32_t symbolCount() const { return symbols.size(); }
+
+    // Writes the index to a temporary file and renames it into place.
+    bool save(const std::string& path) const {
+        using namespace xref;
+        const uint32_t symbolTotal = symbols.size();
+
+        // Symbols in lexeme order
+        std::vector<uint32_t> order(symbolTotal), rank(symbolTotal);
+        for (uint32_t id = 0; id < symbolTotal; ++id) order[id] = id;
+        std::sort(order.begin(), order.end(),
+                  [&](uint32_t a, uint32_t b) { return symbols.lexeme(a) < symbols.lexeme(b); });
+        for (uint32_t r = 0; r < symbolTotal; ++r) rank[order[r]] = r;
+
+        std::vector<std::string> sections(SECTION_COUNT);
+
+        // Files: names, occurrence ranges, skip tables and offset streams
+        std::vector<uint64_t> nameStarts = {0}, occStarts, skipStarts = {0};
+        std::vector<Skip> skips;
+        std::string& stream = sections[FILE_STREAM];
+        for (size_t f = 0; f < files.size(); ++f) {
+            sections[FILE_NAME_BYTES] += files[f];
+            nameStarts.push_back(sections[FILE_NAME_BYTES].size());
+            size_t begin = fileOccStart[f], end = f + 1 < files.size() ? fileOccStart[f + 1] : occs.size();
+            occStarts.push_back(begin);
+            uint64_t prev = 0;
+            for (size_t i = begin; i < end; ++i) {
+                if ((i - begin) % SKIP_INTERVAL == 0) {
+                    skips.push_back({occs[i].offset, stream.size()});
+                    prev = 0;
+                }
+                putVarint(stream, occs[i].offset - prev);
+                putVarint(stream, rank[occs[i].symbol]);
+                prev = occs[i].offset;
+            }
+            skipStarts.push_back(skips.size());
+        }
+        occStarts.push_back(occs.size());
+        sections[FILE_NAME_STARTS] = asBytes(nameStarts);
+        sections[FILE_OCC_STARTS] = asBytes(occStarts);
+        sections[FILE_SKIP_STARTS] = asBytes(skipStarts);
+        sections[SKIPS] = asBytes(skips);
+
+        // Symbols: lexemes, kinds and posting lists (counting sort by rank
+        // keeps each list in file, then offset order)
+        std::vector<uint64_t> lexStarts = {0}, postStarts(symbolTotal + 1, 0);
+        std::string& kindBytes = sections[SYMBOL_KINDS];
+        for (uint32_t r = 0; r < symbolTotal; ++r) {
+            sections[SYMBOL_LEXEME_BYTES] += symbols.lexeme(order[r]);
+            lexStarts.push_back(sections[SYMBOL_LEXEME_BYTES].size());
+            kindBytes.push_back(kinds[order[r]]);
+        }
+        std::vector<uint32_t> byRank(occs.size()), fill(symbolTotal + 1, 0);
+        for (auto& o : occs) ++fill[rank[o.symbol] + 1];
+        for (uint32_t r = 0; r < symbolTotal; ++r) fill[r + 1] += fill[r];
+        for (uint32_t i = 0; i < occs.size(); ++i) byRank[fill[rank[occs[i].symbol]]++] = i;
+
+        std::string& postings = sections[POSTINGS];
+        size_t i = 0;
+        for (uint32_t r = 0; r < symbolTotal; ++r) {
+            uint32_t prevFile = 0;
+            uint64_t prevOffset = 0;
+            for (; i < byRank.size() && rank[occs[byRank[i]].symbol] == r; ++i) {
+                const Occ& o = occs[byRank[i]];
+                if (o.file != prevFile) prevOffset = 0;
+                putVarint(postings, o.file - prevFile);
+                putVarint(postings, o.offset - prevOffset);
+                prevFile = o.file;
+                prevOffset = o.offset;
+            }
+            postStarts[r + 1] = postings.size();
+        }
+        sections[SYMBOL_LEXEME_STARTS] = asBytes(lexStarts);
+        sections[POSTING_STARTS] = asBytes(postStarts);
+
+        Header header = {};
+        std::memcpy(header.magic, MAGIC, 4);
+        header.version = VERSION;
+        header.fileCount = files.size();
+        header.symbolCount = symbolTotal;
+        header.occurrenceCount = occs.size();
+        uint64_t pos = align8(sizeof header);
+        for (int s = 0; s < SECTION_COUNT; ++s) {
+            header.sections[s] = pos;
+            pos = align8(pos + sections[s].size());
+        }
+        header.sections[SECTION_COUNT] = pos;
+
+        std::string tmp = path + ".tmp" + std::to_string(getpid());
+        FILE* out = std::fopen(tmp.c_str(), "wb");
+        if (!out) return false;
+        static const char zeros[8] = {};
+        bool ok = std::fwrite(&header, sizeof header, 1, out) == 1;
+        uint64_t written = sizeof header;
+        for (int s = 0; s < SECTION_COUNT && ok; ++s) {
+            ok = std::fwrite(zeros, 1, header.sections[s] - written, out) == header.sections[s] - written &&
+                 std::fwrite(sections[s].data(), 1, sections[s].size(), out) == sections[s].size();
+            written = header.sections[s] + sections[s].size();
+        }
+        ok = ok && std::fwrite(zeros, 1, pos - written, out) == pos - written;
+        ok = std::fclose(out) == 0 && ok;
+        if (ok && std::rename(tmp.c_str(), path.c_str()) == 0) return true;
+        std::remove(tmp.c_str());
+        return false;
+    }
+
+private:
+    struct Occ {
+        uint32_t file;
+        uint32_t symbol;
+        uint64_t offset;
+    };
+    std::vector<std::string> files;
+    std::vector<size_t> fileOccStart;
+    StringInterner symbols;
+    std::string kinds;
+    std::vector<Occ> occs;
+
+    static uint64_t align8(uint64_t n) { return (n + 7) & ~7ull; }
+
+    template <typename T>
+    static std::string asBytes(const std::vector<T>& v) {
+        return std::string(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(T));
+    }
+};
+
+// Read-only view of a saved index, queried in place.
+class XrefIndex {
+public:
+    explicit XrefIndex(const std::string& path) : file(path) {
+        using namespace xref;
+        std::string_view data = file.view();
+        if (!file.is_open() || data.size() < sizeof(Header)) return;
+        std::memcpy(&header, data.data(), sizeof header);
+        if (std::memcmp(header.magic, MAGIC, 4) != 0 || header.version != VERSION ||
+            header.sections[SECTION_COUNT] != data.size())
+            return;
+        if (header.sections[0] < sizeof(Header)) return;
+        for (int s = 0; s < SECTION_COUNT; ++s)
+            if (header.sections[s] % 8 || header.sections[s] > header.sections[s + 1]) return;
+        base = reinterpret_cast<const unsigned char*>(data.data());
+
+        // Fixed-size sections must hold what the counts promise, and every
+        // start array must rise through its byte section, so the accessors
+        // below need no bounds checks of their own.
+        const uint64_t files = header.fileCount, symbols = header.symbolCount;
+        if (files >= NOT_FOUND || symbols >= NOT_FOUND || !holds(FILE_NAME_STARTS, files + 1, 8) ||
+            !holds(FILE_OCC_STARTS, files + 1, 8) || !holds(FILE_SKIP_STARTS, files + 1, 8) ||
+            !holds(SYMBOL_LEXEME_STARTS, symbols + 1, 8) || !holds(SYMBOL_KINDS, symbols, 1) ||
+            !holds(POSTING_STARTS, symbols + 1, 8))
+            return;
+        if (!rising(FILE_NAME_STARTS, files, size(FILE_NAME_BYTES)) ||
+            !rising(FILE_OCC_STARTS, files, header.occurrenceCount) ||
+            !rising(FILE_SKIP_STARTS, files, size(SKIPS) / sizeof(Skip)) ||
+            !rising(SYMBOL_LEXEME_STARTS, symbols, size(SYMBOL_LEXEME_BYTES)) ||
+            !rising(POSTING_STARTS, symbols, size(POSTINGS)) ||
+            section<uint64_t>(FILE_OCC_STARTS)[files] != header.occurrenceCount)
+            return;
+        // symbolAt counts entries per block from the skip table
+        const uint64_t* occStarts = section<uint64_t>(FILE_OCC_STARTS);
+        const uint64_t* skipStarts = section<uint64_t>(FILE_SKIP_STARTS);
+        for (uint64_t f = 0; f < files; ++f)
+            if (skipStarts[f + 1] - skipStarts[f] != (occStarts[f + 1] - occStarts[f] + SKIP_INTERVAL - 1) / SKIP_INTERVAL)
+                return;
+        ok = true;
+    }
+
+    bool valid() const { return ok; }
+    uint64_t fileCount() const { return header.fileCount; }
+    uint64_t symbolCount() const { return header.symbolCount; }
+    uint64_t occurrenceCount() const { return header.occurrenceCount; }
+
+    std::string_view fileName(uint32_t f) const {
+        const uint64_t* starts = section<uint64_t>(xref::FILE_NAME_STARTS);
+        return std::string_view(section<char>(xref::FILE_NAME_BYTES) + starts[f], starts[f + 1] - starts[f]);
+    }
+
+    uint32_t findFile(std::string_view name) const {
+        for (uint32_t f = 0; f < header.fileCount; ++f)
+            if (fileName(f) == name) return f;
+        return xref::NOT_FOUND;
+    }
+
+    std::string_view lexeme(uint32_t s) const {
+        const uint64_t* starts = section<uint64_t>(xref::SYMBOL_LEXEME_STARTS);
+        return std::string_view(section<char>(xref::SYMBOL_LEXEME_BYTES) + starts[s], starts[s + 1] - starts[s]);
+    }
+
+    unsigned char kind(uint32_t s) const { return section<unsigned char>(xref::SYMBOL_KINDS)[s]; }
+
+    uint32_t findSymbol(std::string_view name) const {
+        uint32_t lo = 0, hi = header.symbolCount;
+        while (lo < hi) {
+            uint32_t mid = lo + (hi - lo) / 2;
+            if (lexeme(mid) < name) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo < header.symbolCount && lexeme(lo) == name ? lo : xref::NOT_FOUND;
+    }
+
+    // Calls f(file, offset) for every use of symbol s, in file and offset order.
+    template <typename F>
+    void forEachUse(uint32_t s, F&& f) const {
+        const uint64_t* starts = section<uint64_t>(xref::POSTING_STARTS);
+        const unsigned char* p = section<unsigned char>(xref::POSTINGS) + starts[s];
+        const unsigned char* end = section<unsigned char>(xref::POSTINGS) + starts[s + 1];
+        uint64_t file = 0, offset = 0, fileDelta, offsetDelta;
+        while (p < end) {
+            if (!xref::getVarint(p, end, fileDelta) || !xref::getVarint(p, end, offsetDelta)) return;
+            if (fileDelta) offset = 0;
+            file += fileDelta;
+            offset += offsetDelta;
+            if (file >= header.fileCount) return;
+            f((uint32_t)file, offset);
+        }
+    }
+
+    // Symbol whose occurrence covers byte offset in file, or NOT_FOUND;
+    // start receives where that occurrence begins.
+    uint32_t symbolAt(uint32_t f, uint64_t offset, uint64_t& start) const {
+        using namespace xref;
+        const uint64_t* skipStarts = section<uint64_t>(FILE_SKIP_STARTS);
+        const uint64_t* occStarts = section<uint64_t>(FILE_OCC_STARTS);
+        const Skip* skips = section<Skip>(SKIPS);
+        const Skip* first = skips + skipStarts[f];
+        const Skip* last = skips + skipStarts[f + 1];
+        const Skip* block = std::upper_bound(first, last, offset,
+                                             [](uint64_t o, const Skip& s) { return o < s.firstOffset; });
+        if (block == first) return NOT_FOUND;
+        --block;
+
+        uint64_t remaining = std::min<uint64_t>(SKIP_INTERVAL, occStarts[f + 1] - occStarts[f] - (block - first) * SKIP_INTERVAL);
+        if (block->bytePos > size(FILE_STREAM)) return NOT_FOUND;
+        const unsigned char* p = section<unsigned char>(FILE_STREAM) + block->bytePos;
+        const unsigned char* end = section<unsigned char>(FILE_STREAM) + size(FILE_STREAM);
+        uint64_t at = 0, delta, s;
+        uint32_t found = NOT_FOUND;
+        for (; remaining > 0; --remaining) {
+            if (!getVarint(p, end, delta) || !getVarint(p, end, s) || s >= header.symbolCount) break;
+            at += delta;
+            if (at > offset) break;
+            if (offset < at + lexeme(s).size()) {
+                found = s;
+                start = at;
+            }
+        }
+        return found;
+    }
+
+private:
+    MappedFile file;
+    xref::Header header = {};
+    const unsigned char* base = nullptr;
+    bool ok = false;
+
+    template <typename T>
+    const T* section(int s) const {
+        return reinterpret_cast<const T*>(base + header.sections[s]);
+    }
+
+    uint64_t size(int s) const { return header.sections[s + 1] - header.sections[s]; }
+
+    bool holds(int s, uint64_t count, uint64_t width) const { return count <= size(s) / width; }
+
+    // starts[0..count] begins at 0, never falls, and ends within limit.
+    bool rising(int s, uint64_t count, uint64_t limit) const {
+        const uint64_t* starts = section<uint64_t>(s);
+        if (starts[0] != 0) return false;
+        for (uint64_t i = 0; i < count; ++i)
+            if (starts[i + 1] < starts[i]) return false;
+        return starts[count] <= limit;
+    }
+};
+
+#endif